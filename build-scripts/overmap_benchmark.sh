@@ -0,0 +1,16 @@
+#!/bin/bash
+
+# Runs the hidden overmap generation benchmark once for each set of in-repo mods that can be
+# loaded together, so the specials of every mod are placed.  Run from the repository root
+# after building the tests; each run is written to overmap_benchmark.<n>.json.
+
+set -eo pipefail
+
+n=0
+./build-scripts/get_all_mods.py | \
+    while read mods
+    do
+        ./tests/cata_test --user-dir=overmap_benchmark --mods="${mods}" '[overmap_benchmark]'
+        mv overmap_benchmark.json "overmap_benchmark.${n}.json"
+        n=$((n + 1))
+    done
@@ -8,9 +8,11 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "requirements.h"
 #include "type_id.h"
@@ -157,6 +159,89 @@ struct activity_reason_info {
 
 int butcher_time_to_cut( Character &you, const item &corpse_item, butcher_type action );
 
+// The tiles a character found there is nothing to do at in their multi-activity, so that long
+// activities don't look at all of them again every turn.  Only kept for the activities where
+// that comes down to what is on the tile itself, and until the zones change or what is on the
+// tile does.  Also forgotten after a while, farm plots may have become warm enough to plant.
+class settled_activity_tiles
+{
+    public:
+        static bool applies_to( const activity_id &act );
+
+        // Forgets every tile if the activity, the zones or the time call for it
+        void reset_if_stale( const activity_id &act );
+        bool has( const tripoint_abs_ms &p ) const;
+        void add( const tripoint_abs_ms &p );
+
+    private:
+        static constexpr time_duration max_age = 30_minutes;
+
+        struct tile_state {
+            ter_id ter;
+            furn_id furn;
+            size_t items;
+
+            bool operator==( const tile_state &rhs ) const {
+                return ter == rhs.ter && furn == rhs.furn && items == rhs.items;
+            }
+        };
+
+        static std::optional<tile_state> state_at( const tripoint_abs_ms &p );
+
+        activity_id act;
+        int revision = -1;
+        time_point expires = calendar::before_time_starts;
+        std::unordered_map<tripoint_abs_ms, tile_state> tiles;
+};
+
+// Where sorting loot sends the items a character has seen, kept for the items seen after them.
+// Piles of loot are mostly the same few items, and the zones an item may go to are the same for
+// every item of the zone type, unless the zone filters its items.  Kept while the character sorts
+// from places that have the same parts of zones near them, so in a base whose zones are all in
+// range of the places sorted from, for the whole sort, and until the zones change.
+class loot_sort_plan
+{
+    public:
+        loot_sort_plan();
+        loot_sort_plan( const loot_sort_plan & );
+        loot_sort_plan( loot_sort_plan && ) noexcept;
+        ~loot_sort_plan();
+        loot_sort_plan &operator=( const loot_sort_plan & );
+        loot_sort_plan &operator=( loot_sort_plan && ) noexcept;
+
+        // Forgets the plan unless the zones near @p from are the ones it was made for
+        void reset_if_stale( const tripoint_abs_ms &from, const faction_id &fac );
+
+        struct destination {
+            zone_type_id id;
+            // the places in range that take the item
+            const std::unordered_set<tripoint_abs_ms> *places;
+        };
+
+        // The places stay put while the plan is kept, except for an item that can't be planned
+        // for, whose places are only good until the next such item.
+        destination destination_of( const item &it );
+
+    private:
+        // kept small, it is searched for every item
+        static constexpr size_t max_items = 64;
+
+        struct planned_item;
+
+        tripoint_abs_ms from;
+        faction_id fac;
+        int revision = -1;
+        // what get_near_parts found near the places the plan was made for
+        std::vector<tripoint_abs_ms> near_parts;
+        // a list, the places returned for an item stay put when more are added
+        std::list<planned_item> items;
+        std::unordered_map<zone_type_id, std::unordered_set<tripoint_abs_ms>> places_of_type;
+        // the places of the last item that can't be planned for, if its zone filters them
+        std::optional<std::unordered_set<tripoint_abs_ms>> unplanned_places;
+
+        destination destination_of( const planned_item &planned );
+};
+
 // activity_item_handling.cpp
 void activity_on_turn_drop();
 void activity_on_turn_move_loot( player_activity &act, Character &you );
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -19,6 +20,7 @@
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
+#include "character_id.h"
 #include "clzones.h"
 #include "colony.h"
 #include "construction.h"
@@ -145,6 +147,7 @@ static const zone_type_id zone_type_LOOT_CORPSE( "LOOT_CORPSE" );
 static const zone_type_id zone_type_LOOT_CUSTOM( "LOOT_CUSTOM" );
 static const zone_type_id zone_type_LOOT_IGNORE( "LOOT_IGNORE" );
 static const zone_type_id zone_type_LOOT_IGNORE_FAVORITES( "LOOT_IGNORE_FAVORITES" );
+static const zone_type_id zone_type_LOOT_ITEM_GROUP( "LOOT_ITEM_GROUP" );
 static const zone_type_id zone_type_LOOT_UNSORTED( "LOOT_UNSORTED" );
 static const zone_type_id zone_type_LOOT_WOOD( "LOOT_WOOD" );
 static const zone_type_id zone_type_MINING( "MINING" );
@@ -1988,6 +1991,70 @@ static bool chop_plank_activity( Character &you, const tripoint_bub_ms &src_loc
     return false;
 }
 
+struct loot_sort_plan::planned_item {
+    item example;
+    zone_type_id id;
+    // only for zones that filter their items
+    std::optional<std::unordered_set<tripoint_abs_ms>> places;
+};
+
+loot_sort_plan::loot_sort_plan() = default;
+loot_sort_plan::loot_sort_plan( const loot_sort_plan & ) = default;
+loot_sort_plan::loot_sort_plan( loot_sort_plan && ) noexcept = default;
+loot_sort_plan::~loot_sort_plan() = default;
+loot_sort_plan &loot_sort_plan::operator=( const loot_sort_plan & ) = default;
+loot_sort_plan &loot_sort_plan::operator=( loot_sort_plan && ) noexcept = default;
+
+void loot_sort_plan::reset_if_stale( const tripoint_abs_ms &from, const faction_id &fac )
+{
+    const zone_manager &mgr = zone_manager::get_manager();
+    const int revision = mgr.get_revision();
+    std::vector<tripoint_abs_ms> near_parts = mgr.get_near_parts( from, ACTIVITY_SEARCH_DISTANCE,
+            fac );
+    if( fac != this->fac || revision != this->revision || near_parts != this->near_parts ||
+        items.size() >= max_items ) {
+        *this = loot_sort_plan();
+        this->fac = fac;
+        this->revision = revision;
+        this->near_parts = std::move( near_parts );
+    }
+    // the zones near from are the same as near the places the plan was made for
+    this->from = from;
+}
+
+loot_sort_plan::destination loot_sort_plan::destination_of( const item &it )
+{
+    // only items without contents can be the same as another one
+    const bool can_plan = it.get_contents().empty_with_no_mods();
+    if( can_plan ) {
+        for( const planned_item &planned : items ) {
+            if( planned.example.same_for_rle( it ) ) {
+                return destination_of( planned );
+            }
+        }
+    }
+    zone_manager &mgr = zone_manager::get_manager();
+    const zone_type_id id = mgr.get_near_zone_type_for_item( it, from, ACTIVITY_SEARCH_DISTANCE,
+                            fac );
+    std::optional<std::unordered_set<tripoint_abs_ms>> places;
+    if( id == zone_type_LOOT_CUSTOM || id == zone_type_LOOT_ITEM_GROUP ) {
+        places = mgr.get_near( id, from, ACTIVITY_SEARCH_DISTANCE, &it, fac );
+    } else if( places_of_type.count( id ) == 0 ) {
+        places_of_type.emplace( id, mgr.get_near( id, from, ACTIVITY_SEARCH_DISTANCE, &it, fac ) );
+    }
+    if( !can_plan ) {
+        unplanned_places = std::move( places );
+        return { id, unplanned_places ? &*unplanned_places : &places_of_type[id] };
+    }
+    items.push_back( { it, id, std::move( places ) } );
+    return destination_of( items.back() );
+}
+
+loot_sort_plan::destination loot_sort_plan::destination_of( const planned_item &planned )
+{
+    return { planned.id, planned.places ? &*planned.places : &places_of_type[planned.id] };
+}
+
 void activity_on_turn_move_loot( player_activity &act, Character &you )
 {
     enum activity_stage : int {
@@ -2150,6 +2217,8 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
         // TODO: fix point types
         const tripoint_abs_ms src( act.placement );
         const tripoint_bub_ms src_loc = here.bub_from_abs( src );
+        loot_sort_plan &plan = *you.loot_plan;
+        plan.reset_if_stale( abspos, _fac_id( you ) );
 
         bool is_adjacent_or_closer = square_dist( you.pos_bub(), src_loc ) <= 1;
         // before we move any item, check if player is at or
@@ -2215,8 +2284,8 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
 
             // Only if it's from a vehicle do we use the vehicle source location information.
             const std::optional<vpart_reference> vpr_src = it->second ? vpr : std::nullopt;
-            const zone_type_id id = mgr.get_near_zone_type_for_item( thisitem, abspos,
-                                    ACTIVITY_SEARCH_DISTANCE, _fac_id( you ) );
+            const loot_sort_plan::destination dest = plan.destination_of( thisitem );
+            const zone_type_id &id = dest.id;
 
             // checks whether the item is already on correct loot zone or not
             // if it is, we can skip such item, if not we move the item to correct pile
@@ -2230,8 +2299,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                 continue;
             }
 
-            const std::unordered_set<tripoint_abs_ms> dest_set =
-                mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE, &thisitem, _fac_id( you ) );
+            const std::unordered_set<tripoint_abs_ms> &dest_set = *dest.places;
 
             // if this item isn't going anywhere and its not sealed
             // check if it is in a unload zone or a strip corpse zone
@@ -3150,6 +3218,48 @@ static bool generic_multi_activity_do(
     return true;
 }
 
+bool settled_activity_tiles::applies_to( const activity_id &act )
+{
+    return act == ACT_MULTIPLE_FARM || act == ACT_MULTIPLE_CHOP_TREES ||
+           act == ACT_MULTIPLE_CHOP_PLANKS || act == ACT_MULTIPLE_MINE ||
+           act == ACT_MULTIPLE_FISH;
+}
+
+void settled_activity_tiles::reset_if_stale( const activity_id &act )
+{
+    const int revision = zone_manager::get_manager().get_revision();
+    if( act != this->act || revision != this->revision || calendar::turn >= expires ) {
+        *this = settled_activity_tiles();
+        this->act = act;
+        this->revision = revision;
+        expires = calendar::turn + max_age;
+    }
+}
+
+bool settled_activity_tiles::has( const tripoint_abs_ms &p ) const
+{
+    const auto found = tiles.find( p );
+    return found != tiles.end() && state_at( p ) == found->second;
+}
+
+void settled_activity_tiles::add( const tripoint_abs_ms &p )
+{
+    if( std::optional<tile_state> state = state_at( p ) ) {
+        tiles[p] = *state;
+    }
+}
+
+std::optional<settled_activity_tiles::tile_state> settled_activity_tiles::state_at(
+    const tripoint_abs_ms &p )
+{
+    map &here = get_map();
+    const tripoint_bub_ms pos = here.bub_from_abs( p );
+    if( !here.inbounds( pos ) ) {
+        return std::nullopt;
+    }
+    return tile_state{ here.ter( pos ), here.furn( pos ), here.i_at( pos ).size() };
+}
+
 bool generic_multi_activity_handler( player_activity &act, Character &you, bool check_only )
 {
     map &here = get_map();
@@ -3164,6 +3274,11 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
     // the set of target work spots - potentially after we have fetched required tools.
     std::unordered_set<tripoint_abs_ms> src_set =
         generic_multi_activity_locations( you, activity_to_restore );
+    settled_activity_tiles *settled = nullptr;
+    if( settled_activity_tiles::applies_to( activity_to_restore ) ) {
+        settled = &*you.settled_tiles;
+        settled->reset_if_stale( activity_to_restore );
+    }
     // now we have our final set of points
     std::vector<tripoint_abs_ms> src_sorted = get_sorted_tiles_by_distance( abspos, src_set );
     // now loop through the work-spot tiles and judge whether its worth traveling to it yet
@@ -3202,12 +3317,20 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
             you.set_destination( route, player_activity( activity_to_restore ) );
             return false;
         }
+        if( settled && settled->has( src ) ) {
+            continue;
+        }
         activity_reason_info act_info = can_do_activity_there( activity_to_restore, you,
                                         src_loc, ACTIVITY_SEARCH_DISTANCE );
         // see activity_handlers.h enum for requirement_check_result
         const requirement_check_result req_res = generic_multi_activity_check_requirement(
                     you, activity_to_restore, act_info, src, src_loc, src_set, check_only );
         if( req_res == requirement_check_result::SKIP_LOCATION ) {
+            // nothing to do there until the tile changes, whatever we carry
+            if( settled && ( act_info.reason == do_activity_reason::NO_ZONE ||
+                             act_info.reason == do_activity_reason::ALREADY_DONE ) ) {
+                settled->add( src );
+            }
             continue;
         } else if( req_res == requirement_check_result::RETURN_EARLY ) {
             return true;
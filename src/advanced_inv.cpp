@@ -42,6 +42,7 @@
 #include "item_category.h"
 #include "item_contents.h"
 #include "item_location.h"
+#include "item_tname.h"
 #include "localized_comparator.h"
 #include "map.h"
 #include "messages.h"
@@ -1762,6 +1763,8 @@ void advanced_inventory::display()
 {
     avatar &player_character = get_avatar();
     input_context ctxt{ register_ctxt() };
+    // both panes ask for every visible name on each redraw
+    tname::cache_scope name_cache;
 
     exit = false;
     if( !is_processing() ) {
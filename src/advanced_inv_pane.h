@@ -144,6 +144,7 @@ class advanced_inventory_pane
         /** Only add offset to index, but wrap around! */
         void mod_index( int offset );
 
-        mutable std::map<std::string, std::function<bool( const item & )>> filtercache;
+        // @ref filter compiled, set when it's first used
+        mutable std::function<bool( const item & )> filter_fn;
 };
 #endif // CATA_SRC_ADVANCED_INV_PANE_H
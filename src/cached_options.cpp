@@ -1,6 +1,7 @@
 #include "cached_options.h"
 
 int fov_3d_z_range;
+int turn_time_budget;
 bool keycode_mode;
 bool log_from_top;
 int message_ttl;
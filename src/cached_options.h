@@ -11,6 +11,7 @@
 // options.cpp).
 
 extern int fov_3d_z_range;
+extern int turn_time_budget;
 extern bool keycode_mode;
 extern bool log_from_top;
 extern int message_ttl;
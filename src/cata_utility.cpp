@@ -94,30 +94,46 @@ bool lcmatch( const std::string_view str, const std::string_view qry )
     if( qry.empty() ) {
         return true;
     }
+    return lcmatch_query( qry ).matches( str );
+}
+
+bool lcmatch( const translation &str, const std::string_view qry )
+{
+    return lcmatch( str.translated(), qry );
+}
+
+lcmatch_query::lcmatch_query( const std::string_view qry ) : qry( utf8_to_utf32( qry ) )
+{
+    std::for_each( this->qry.begin(), this->qry.end(), u32_to_lowercase );
+}
+
+bool lcmatch_query::matches( const std::string_view str ) const
+{
+    if( qry.empty() ) {
+        return true;
+    }
 
     std::u32string u32_str = utf8_to_utf32( str );
-    std::u32string u32_qry = utf8_to_utf32( qry );
     std::for_each( u32_str.begin(), u32_str.end(), u32_to_lowercase );
-    std::for_each( u32_qry.begin(), u32_qry.end(), u32_to_lowercase );
     // First try match their lowercase forms
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( qry ) != std::u32string::npos ) {
         return true;
     }
     // Then try removing accents from str ONLY
     std::for_each( u32_str.begin(), u32_str.end(), remove_accent );
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( qry ) != std::u32string::npos ) {
         return true;
     }
     if( use_pinyin_search ) {
         // Finally, try to convert the string to pinyin and compare
-        return pinyin::pinyin_match( u32_str, u32_qry );
+        return pinyin::pinyin_match( u32_str, qry );
     }
     return false;
 }
 
-bool lcmatch( const translation &str, const std::string_view qry )
+bool lcmatch_query::matches( const translation &str ) const
 {
-    return lcmatch( str.translated(), qry );
+    return matches( str.translated() );
 }
 
 bool match_include_exclude( const std::string_view text, std::string filter )
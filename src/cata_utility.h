@@ -112,6 +112,20 @@ bool isBetween( int test, int down, int up );
 bool lcmatch( std::string_view str, std::string_view qry );
 bool lcmatch( const translation &str, std::string_view qry );
 
+/**
+ * The query of @ref lcmatch, converted once for matching it against many strings.
+ */
+class lcmatch_query
+{
+    public:
+        explicit lcmatch_query( std::string_view qry );
+        bool matches( std::string_view str ) const;
+        bool matches( const translation &str ) const;
+
+    private:
+        std::u32string qry;
+};
+
 /**
  * Matches text case insensitive with the include/exclude rules of the filter
  *
@@ -689,6 +689,7 @@ item_location Character::get_wielded_item()
 
 void Character::set_wielded_item( const item &to_wield )
 {
+    item::note_type_or_contents_change();
     weapon = to_wield;
 }
 
@@ -2651,8 +2652,9 @@ void Character::flag_encumbrance()
 
 void Character::check_item_encumbrance_flag()
 {
-    if( worn.check_item_encumbrance_flag( check_encumbrance ) ) {
-        calc_encumbrance();
+    body_part_set changed_parts;
+    if( worn.check_item_encumbrance_flag( check_encumbrance, changed_parts ) ) {
+        calc_encumbrance( changed_parts );
     }
 }
 
@@ -3889,6 +3891,28 @@ void Character::calc_encumbrance( const item &new_item )
 
 }
 
+void Character::calc_encumbrance( const body_part_set &parts )
+{
+    body_part_set changed_parts = parts;
+    worn.check_item_encumbrance_flag( false, changed_parts );
+    if( check_encumbrance ) {
+        calc_encumbrance();
+        return;
+    }
+
+    std::map<bodypart_id, encumbrance_data> enc;
+    worn.item_encumb( enc, item(), *this, changed_parts );
+    mut_cbm_encumb( enc );
+    calc_bmi_encumb( enc );
+
+    for( const std::pair<const bodypart_id, encumbrance_data> &elem : enc ) {
+        // the others only got the encumbrance of mutations, bionics and BMI
+        if( changed_parts.test( elem.first.id() ) ) {
+            set_part_encumbrance_data( elem.first, elem.second );
+        }
+    }
+}
+
 units::mass Character::get_weight() const
 {
     units::mass ret = 0_gram;
@@ -9334,23 +9358,25 @@ void Character::cache_visit_items_with( const std::string &key, const itype_id &
                                         const flag_id &type_flag, bool( item::*filter_func )() const,
                                         const std::function<void( item & )> &do_func )
 {
-    // If the cache already exists, use it. Remove all invalid item references.
+    // If the cache already exists, use it. Remove all invalid item references, and items that changed type.
     auto found_cache = inv_search_caches.find( key );
     if( found_cache != inv_search_caches.end() ) {
-        inv_search_caches[key].items.erase( std::remove_if( inv_search_caches[key].items.begin(),
-        inv_search_caches[key].items.end(), [&do_func]( const safe_reference<item> &it ) {
-            if( it ) {
+        inv_search_cache &cache = found_cache->second;
+        cache.items.erase( std::remove_if( cache.items.begin(),
+        cache.items.end(), [&do_func, &cache]( const safe_reference<item> &it ) {
+            if( it && cache.still_matches( *it ) ) {
                 do_func( *it );
                 return false;
             }
             return true;
-        } ), inv_search_caches[key].items.end() );
+        } ), cache.items.end() );
         return;
     } else {
         // Otherwise, add a new cache and populate with all appropriate items in the inventory. Empty lists are still created.
         inv_search_caches[key].type = type;
         inv_search_caches[key].type_flag = type_flag;
         inv_search_caches[key].filter_func = filter_func;
+        inv_search_caches[key].item_changes = item::type_or_contents_changes();
         visit_items( [&]( item * it, item * ) {
             if( ( !type.is_valid() || it->typeId() == type ) &&
                 ( !type_flag.is_valid() || it->type->has_flag( type_flag ) ) &&
@@ -9386,23 +9412,25 @@ void Character::cache_visit_items_with( const std::string &key, const itype_id &
                                         const flag_id &type_flag, bool( item::*filter_func )() const,
                                         const std::function<void( const item & )> &do_func ) const
 {
-    // If the cache already exists, use it. Remove all invalid item references.
+    // If the cache already exists, use it. Remove all invalid item references, and items that changed type.
     auto found_cache = inv_search_caches.find( key );
     if( found_cache != inv_search_caches.end() ) {
-        inv_search_caches[key].items.erase( std::remove_if( inv_search_caches[key].items.begin(),
-        inv_search_caches[key].items.end(), [&do_func]( const safe_reference<item> &it ) {
-            if( it ) {
+        inv_search_cache &cache = found_cache->second;
+        cache.items.erase( std::remove_if( cache.items.begin(),
+        cache.items.end(), [&do_func, &cache]( const safe_reference<item> &it ) {
+            if( it && cache.still_matches( *it ) ) {
                 do_func( *it );
                 return false;
             }
             return true;
-        } ), inv_search_caches[key].items.end() );
+        } ), cache.items.end() );
         return;
     } else {
         // Otherwise, add a new cache and populate with all appropriate items in the inventory. Empty lists are still created.
         inv_search_caches[key].type = type;
         inv_search_caches[key].type_flag = type_flag;
         inv_search_caches[key].filter_func = filter_func;
+        inv_search_caches[key].item_changes = item::type_or_contents_changes();
         visit_items( [&]( item * it, item * ) {
             if( ( !type.is_valid() || it->typeId() == type ) &&
                 ( !type_flag.is_valid() || it->type->has_flag( type_flag ) ) &&
@@ -9440,12 +9468,13 @@ bool Character::cache_has_item_with( const std::string &key, const itype_id &typ
 {
     bool aborted = false;
 
-    // If the cache already exists, use it. Stop iterating if the check_func ever returns true. Remove any invalid item references encountered.
+    // If the cache already exists, use it. Stop iterating if the check_func ever returns true. Remove any invalid item references
+    // and items that changed type encountered.
     auto found_cache = inv_search_caches.find( key );
     if( found_cache != inv_search_caches.end() ) {
         for( auto iter = found_cache->second.items.begin();
              iter != found_cache->second.items.end(); ) {
-            if( *iter ) {
+            if( *iter && found_cache->second.still_matches( **iter ) ) {
                 if( check_func( **iter ) ) {
                     aborted = true;
                     break;
@@ -9460,6 +9489,7 @@ bool Character::cache_has_item_with( const std::string &key, const itype_id &typ
         inv_search_caches[key].type = type;
         inv_search_caches[key].type_flag = type_flag;
         inv_search_caches[key].filter_func = filter_func;
+        inv_search_caches[key].item_changes = item::type_or_contents_changes();
         visit_items( [&]( item * it, item * ) {
             if( ( !type.is_valid() || it->typeId() == type ) &&
                 ( !type_flag.is_valid() || it->type->has_flag( type_flag ) ) &&
@@ -9485,6 +9515,25 @@ bool Character::has_item_with_flag( const flag_id &flag, bool need_charges ) con
     } );
 }
 
+bool Character::cache_has_item_with_exact( const itype_id &type,
+        const std::function<bool( const item & )> &check_func ) const
+{
+    const std::string key = "HAS TYPE " + type.str();
+    const auto found_cache = inv_search_caches.find( key );
+    if( found_cache != inv_search_caches.end() &&
+        found_cache->second.item_changes != item::type_or_contents_changes() ) {
+        // An item may have become this type, or been put somewhere the cache didn't see
+        inv_search_caches.erase( found_cache );
+    }
+    return cache_has_item_with( key, type, {}, nullptr, check_func );
+}
+
+bool Character::inv_search_cache::still_matches( const item &it ) const
+{
+    return ( !type.is_valid() || it.typeId() == type ) &&
+           ( !type_flag.is_valid() || it.type->has_flag( type_flag ) );
+}
+
 bool Character::cache_has_item_with_flag( const flag_id &type_flag, bool need_charges ) const
 {
     return cache_has_item_with( "HAS FLAG " + type_flag.str(), {}, type_flag, nullptr,
@@ -12866,10 +12915,8 @@ void Character::process_items()
     }
 
     // Active item processing done, now we're recharging.
-    if( worn.check_item_encumbrance_flag( get_check_encumbrance() ) ) {
-        calc_encumbrance();
-        set_check_encumbrance( false );
-    }
+    check_item_encumbrance_flag();
+    set_check_encumbrance( false );
 
     // Load all items that use the UPS and have their own battery to their minimal functional charge,
     // The tool is not really useful if its charges are below charges_to_use
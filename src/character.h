@@ -3,6 +3,7 @@
 #define CATA_SRC_CHARACTER_H
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <climits>
 #include <cstdint>
@@ -73,6 +74,7 @@ class effect_source;
 class faction;
 class item_pocket;
 class known_magic;
+class loot_sort_plan;
 class ma_technique;
 class map;
 class monster;
@@ -82,6 +84,7 @@ class profession;
 class proficiency_set;
 class recipe;
 class recipe_subset;
+class settled_activity_tiles;
 class spell;
 class ui_adaptor;
 class vehicle;
@@ -301,71 +304,66 @@ struct queued_eoc {
         std::unordered_map<std::string, std::string> context;
 };
 
-struct eoc_compare {
-    bool operator()( const queued_eoc &lhs, const queued_eoc &rhs ) const {
-        return lhs.time > rhs.time;
-    }
-};
-
+/**
+ * Queued effect_on_conditions, ordered by the turn they are due.
+ *
+ * The entries live in `list`; scheduling is done by a hierarchical timer wheel holding
+ * iterators into it.  Each level has `wheel_slots` buckets, level 0 buckets are one turn wide
+ * and each level above is `wheel_slots` times coarser.  Inserting is O(1), and advancing the
+ * wheel only touches the bucket(s) for the turns passed, so all EOCs due on the same turn are
+ * taken out in one batch without ever looking at the ones that aren't due yet.
+ */
 struct queued_eocs {
     using storage_iter = std::list<queued_eoc>::iterator;
 
-    struct eoc_compare : ::eoc_compare {
-        bool operator()( const storage_iter &lhs, const storage_iter &rhs ) const {
-            return ::eoc_compare::operator()( *lhs, *rhs );
-        }
-    };
-    std::priority_queue<storage_iter, std::vector<storage_iter>, eoc_compare> queue;
     std::list<queued_eoc> list;
 
     queued_eocs() = default;
-
-    queued_eocs( const queued_eocs &rhs ) {
-        list = rhs.list;
-        for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
-        }
-    };
-    queued_eocs( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
-        list.swap( rhs.list );
-    }
-
-    queued_eocs &operator=( const queued_eocs &rhs ) {
-        list = rhs.list;
-        // Why doesn't std::priority_queue have a clear() function.
-        queue = {};
-        for( auto it = list.begin(), end = list.end(); it != end; ++it ) {
-            queue.emplace( it );
-        }
-        return *this;
-    }
-    queued_eocs &operator=( queued_eocs &&rhs ) noexcept {
-        queue.swap( rhs.queue );
-        list.swap( rhs.list );
-        return *this;
-    }
-
-    /* std::priority_queue compatibility layer where performance is less relevant */
+    queued_eocs( const queued_eocs &rhs );
+    queued_eocs( queued_eocs &&rhs ) noexcept;
+    queued_eocs &operator=( const queued_eocs &rhs );
+    queued_eocs &operator=( queued_eocs &&rhs ) noexcept;
 
     bool empty() const {
-        return queue.empty();
+        return list.empty();
     }
 
-    const queued_eoc &top() const {
-        return *queue.top();
-    }
+    void push( const queued_eoc &eoc );
+    void clear();
+    /** Removes the entries matching `pred` */
+    void remove_if( const std::function<bool( const queued_eoc & )> &pred );
+    /** All entries ordered by the time they are due, for saving and debug output */
+    std::vector<const queued_eoc *> sorted() const;
+
+    /**
+     * Advances the wheel to `now` and moves every entry due at or before it into `due`.
+     * The entries stay in `list` but are no longer scheduled; the caller either erases
+     * them from `list` or hands them back to `schedule`.
+     */
+    void take_due( const time_point &now, std::vector<storage_iter> &due );
+    /** Schedules an entry of `list` that was taken out by `take_due` */
+    void schedule( storage_iter it );
+    /** Spare buffer for the entries taken by `take_due`, so processing the queue doesn't allocate */
+    std::vector<storage_iter> due_buffer;
 
-    void push( const queued_eoc &eoc ) {
-        auto it = list.emplace( list.end(), eoc );
-        queue.push( it );
-    }
-
-    void pop() {
-        auto it = queue.top();
-        queue.pop();
-        list.erase( it );
-    }
+    private:
+        static constexpr int wheel_bits = 6;
+        static constexpr int wheel_slots = 1 << wheel_bits;
+        static constexpr int wheel_levels = 4;
+
+        void place( storage_iter it );
+        // reschedules everything in `list` relative to `now`
+        void rebuild( const time_point &now );
+        void swap( queued_eocs &rhs ) noexcept;
+
+        std::array<std::array<std::vector<storage_iter>, wheel_slots>, wheel_levels> wheel;
+        std::array<int, wheel_levels> level_size = {};
+        // due further ahead than the top level of the wheel covers
+        std::vector<storage_iter> overflow;
+        // already due when they were scheduled
+        std::vector<storage_iter> due_now;
+        // the turn the wheel has been advanced to
+        time_point wheel_time = calendar::turn_zero;
 };
 
 struct aim_type {
@@ -1552,6 +1550,12 @@ class Character : public Creature, public visitable
         void calc_discomfort();
         /** Recalculate encumbrance for all body parts as if `new_item` was also worn. */
         void calc_encumbrance( const item &new_item );
+        /**
+         * Recalculate encumbrance for the body parts covered by an item that was just worn, taken
+         * off or changed, and for those covered by the worn items flagged as changed.  The others
+         * are kept, unless everything has to be recalculated anyway (@ref check_encumbrance).
+         */
+        void calc_encumbrance( const body_part_set &parts );
         // recalculates bodyparts based on enchantments modifying them and the default anatomy.
         void recalculate_bodyparts();
         // recalculates enchantment cache by iterating through all held, worn, and wielded items
@@ -2708,6 +2712,10 @@ class Character : public Creature, public visitable
         player_activity stashed_outbounds_backlog;
         player_activity activity;
         std::list<player_activity> backlog;
+        // the tiles their multi-activity found nothing to do at
+        pimpl<settled_activity_tiles> settled_tiles; // NOLINT(cata-serialize)
+        // where the loot they sort goes
+        pimpl<loot_sort_plan> loot_plan; // NOLINT(cata-serialize)
         std::optional<tripoint> destination_point;
         pimpl<inventory> inv;
         itype_id last_item;
@@ -2862,6 +2870,13 @@ class Character : public Creature, public visitable
                                   bool( item::*filter_func )() const,
                                   const std::function<bool( const item & )> &check_func = return_true<item> ) const;
         /**
+        * @brief Like cache_has_item_with( type, check_func ), but rebuilds the cache first if any item
+        * changed type or was put into a pocket since it was built (see @ref item::type_or_contents_changes),
+        * so it can be used to count the items of the type.
+        */
+        bool cache_has_item_with_exact( const itype_id &type,
+                                        const std::function<bool( const item & )> &check_func ) const;
+        /**
         * @brief Find if the character has an item with a specific flag. Can also checks for charges, if needed.
         */
         bool has_item_with_flag( const flag_id &flag, bool need_charges = false ) const;
@@ -3800,6 +3815,9 @@ class Character : public Creature, public visitable
         int max_quality( const quality_id &qual, int radius ) const;
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        /** Like @ref visit_items with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_items_inline( Visitor &&func ) const;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
                                            int count = INT_MAX ) override;
         int charges_of(
@@ -4075,6 +4093,10 @@ class Character : public Creature, public visitable
             flag_id type_flag;
             bool ( item::*filter_func )() const;
             std::list<safe_reference<item>> items;
+            /** @ref item::type_or_contents_changes when the cache was built */
+            uint64_t item_changes = 0;
+            /** Whether a cached item still has the type and flag the cache is for */
+            bool still_matches( const item &it ) const;
         };
         mutable std::unordered_map<std::string, inv_search_cache> inv_search_caches;
     protected:
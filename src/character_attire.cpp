@@ -381,7 +381,7 @@ std::optional<std::list<item>::iterator> outfit::wear_item( Character &guy, cons
 
     if( do_calc_encumbrance ) {
         guy.recalc_sight_limits();
-        guy.calc_encumbrance();
+        guy.calc_encumbrance( new_item_it->get_covered_body_parts() );
         guy.calc_discomfort();
     }
 
@@ -511,6 +511,7 @@ ret_val<void> Character::can_takeoff( const item &it, const std::list<item> *res
 bool Character::takeoff( item_location loc, std::list<item> *res )
 {
     const std::string name = loc->tname();
+    const body_part_set covered_parts = loc->get_covered_body_parts();
     const bool success = worn.takeoff( loc, res, *this );
 
     if( success ) {
@@ -519,7 +520,7 @@ bool Character::takeoff( item_location loc, std::list<item> *res )
                                name );
 
         recalc_sight_limits();
-        calc_encumbrance();
+        calc_encumbrance( covered_parts );
         worn.recalc_ablative_blocking( this );
         calc_discomfort();
         recoil = MAX_RECOIL;
@@ -776,7 +777,9 @@ bool Character::change_side( item &it, bool interactive )
     }
 
     //if made it here then swap the item
+    body_part_set covered_parts = it.get_covered_body_parts();
     it.swap_side();
+    covered_parts.unify_set( it.get_covered_body_parts() );
 
     if( interactive ) {
         add_msg_player_or_npc( m_info, _( "You swap the side on which your %s is worn." ),
@@ -785,7 +788,7 @@ bool Character::change_side( item &it, bool interactive )
     }
 
     mod_moves( -250 );
-    calc_encumbrance();
+    calc_encumbrance( covered_parts );
     calc_discomfort();
 
     return true;
@@ -820,80 +823,106 @@ bool Character::is_wearing_active_optcloak() const
     return worn.is_wearing_active_optcloak();
 }
 
-static void layer_item( std::map<bodypart_id, encumbrance_data> &vals, const item &it,
-                        std::map<sub_bodypart_id, layer_level> &highest_layer_so_far, const Character &c )
+namespace
 {
-    body_part_set covered_parts = it.get_covered_body_parts();
-    for( const bodypart_id &bp : c.get_all_body_parts() ) {
-        if( !covered_parts.test( bp.id() ) ) {
+
+// What layering needs of a worn item that is the same for all of the body parts it covers
+struct layered_item {
+    const item *it;
+    body_part_set covered_parts;
+    std::vector<sub_bodypart_id> covered_sub_parts;
+    bool semitangible;
+    bool personal;
+
+    explicit layered_item( const item &worn_item ) : it( &worn_item ),
+        covered_parts( worn_item.get_covered_body_parts() ),
+        covered_sub_parts( worn_item.get_covered_sub_body_parts() ),
+        semitangible( worn_item.has_flag( flag_SEMITANGIBLE ) ),
+        personal( worn_item.has_flag( flag_PERSONAL ) ) {}
+};
+
+// A sub part of the body part being layered, with its index in the body part's sub parts
+struct layered_sub_part {
+    sub_bodypart_id sbp;
+    size_t index;
+    std::vector<layer_level> layers;
+};
+
+} // namespace
+
+// `highest_layer_so_far` holds the highest layer seen on each of `bp`'s sub parts, in the
+// order of `bp->sub_parts`
+static void layer_item( encumbrance_data &vals, const layered_item &layered, const bodypart_id &bp,
+                        std::vector<layer_level> &highest_layer_so_far, const Character &c )
+{
+    const item &it = *layered.it;
+    const std::vector<layer_level> item_layers = it.get_layer( bp );
+    int encumber_val = it.get_encumber( c, bp );
+    int layering_encumbrance = clamp( encumber_val, 2, 10 );
+
+    /*
+     * Setting layering_encumbrance to 0 at this point makes the item cease to exist
+     * for the purposes of the layer penalty system. (normally an item has a minimum
+     * layering_encumbrance of 2 )
+     * Personal layer items and semitangible items do not conflict.
+     */
+    if( layered.semitangible ) {
+        encumber_val = 0;
+        layering_encumbrance = 0;
+    }
+    if( layered.personal ) {
+        layering_encumbrance = 0;
+    }
+
+    std::vector<layered_sub_part> sub_parts;
+    for( const sub_bodypart_id &sbp : layered.covered_sub_parts ) {
+        const auto found = std::find( bp->sub_parts.begin(), bp->sub_parts.end(), sbp.id() );
+        if( found == bp->sub_parts.end() ) {
+            // the sub part isn't part of the bodypart we are checking
             continue;
         }
+        sub_parts.push_back( { sbp, static_cast<size_t>( found - bp->sub_parts.begin() ),
+                               it.get_layer( sbp ) } );
+    }
 
-        const std::vector<layer_level> item_layers = it.get_layer( bp );
-        int encumber_val = it.get_encumber( c, bp.id() );
-        int layering_encumbrance = clamp( encumber_val, 2, 10 );
-
-        /*
-         * Setting layering_encumbrance to 0 at this point makes the item cease to exist
-         * for the purposes of the layer penalty system. (normally an item has a minimum
-         * layering_encumbrance of 2 )
-         * Personal layer items and semitangible items do not conflict.
-         */
-        if( it.has_flag( flag_SEMITANGIBLE ) ) {
-            encumber_val = 0;
-            layering_encumbrance = 0;
-        }
-        if( it.has_flag( flag_PERSONAL ) ) {
-            layering_encumbrance = 0;
-        }
-        for( layer_level item_layer : item_layers ) {
-            // do the sublayers of this armor conflict
-            bool conflicts = false;
-
-            // check if we've already added conflict for the layer and body part since each sbp is check individually
-            std::map<layer_level, bool> bpcovered;
-
-            // add the sublocations to the overall body part layer and update if we are conflicting
-            for( sub_bodypart_id &sbp : it.get_covered_sub_body_parts() ) {
-                if( std::count_if( bp->sub_parts.begin(),
-                bp->sub_parts.end(), [sbp]( const sub_bodypart_str_id & bpid ) {
-                return sbp.id() == bpid;
-                } ) == 0 ) {
-                    // the sub part isn't part of the bodypart we are checking
-                    continue;
-                }
-                // bit hacky but needed since we are doing one layer at a time
-                std::vector<layer_level> ll;
-                ll.push_back( item_layer );
-                if( !it.has_layer( ll, sbp ) ) {
-                    // skip this layer and sbp if it doesn't cover it
-                    continue;
-                }
+    for( layer_level item_layer : item_layers ) {
+        // do the sublayers of this armor conflict
+        bool conflicts = false;
 
-                if( item_layer >= highest_layer_so_far[sbp] ) {
-                    conflicts = vals[bp].add_sub_location( item_layer, sbp );
-                } else {
-                    // if it is on a lower layer it conflicts for sure
-                    conflicts = true;
-                }
+        // check if we've already added conflict for the layer and body part since each sbp is check individually
+        std::array<bool, static_cast<size_t>( layer_level::NUM_LAYER_LEVELS )> bpcovered = {};
 
-                highest_layer_so_far[sbp] = std::max( highest_layer_so_far[sbp], item_layer );
+        // add the sublocations to the overall body part layer and update if we are conflicting
+        for( const layered_sub_part &sub : sub_parts ) {
+            if( std::find( sub.layers.begin(), sub.layers.end(), item_layer ) == sub.layers.end() ) {
+                // skip this layer and sbp if it doesn't cover it
+                continue;
+            }
 
-                // Apply layering penalty to this layer, as well as any layer worn
-                // within it that would normally be worn outside of it.
-                for( layer_level penalty_layer = item_layer;
-                     penalty_layer <= highest_layer_so_far[sbp]; ++penalty_layer ) {
+            layer_level &highest_layer = highest_layer_so_far[sub.index];
+            if( item_layer >= highest_layer ) {
+                conflicts = vals.add_sub_location( item_layer, sub.sbp );
+            } else {
+                // if it is on a lower layer it conflicts for sure
+                conflicts = true;
+            }
 
-                    // make sure we haven't already found a subpart that covers and would cause penalty
-                    if( !bpcovered[penalty_layer] ) {
-                        vals[bp].layer( penalty_layer, layering_encumbrance, conflicts );
-                        bpcovered[penalty_layer] = true;
-                    }
+            highest_layer = std::max( highest_layer, item_layer );
+
+            // Apply layering penalty to this layer, as well as any layer worn
+            // within it that would normally be worn outside of it.
+            for( layer_level penalty_layer = item_layer;
+                 penalty_layer <= highest_layer; ++penalty_layer ) {
+
+                // make sure we haven't already found a subpart that covers and would cause penalty
+                if( !bpcovered[static_cast<size_t>( penalty_layer )] ) {
+                    vals.layer( penalty_layer, layering_encumbrance, conflicts );
+                    bpcovered[static_cast<size_t>( penalty_layer )] = true;
                 }
             }
         }
-        vals[bp].armor_encumbrance += encumber_val;
     }
+    vals.armor_encumbrance += encumber_val;
 }
 
 /*
@@ -916,6 +945,14 @@ static void layer_item( std::map<bodypart_id, encumbrance_data> &vals, const ite
 void outfit::item_encumb( std::map<bodypart_id, encumbrance_data> &vals,
                           const item &new_item, const Character &guy ) const
 {
+    body_part_set all_parts;
+    all_parts.fill( guy.get_all_body_parts() );
+    item_encumb( vals, new_item, guy, all_parts );
+}
+
+void outfit::item_encumb( std::map<bodypart_id, encumbrance_data> &vals,
+                          const item &new_item, const Character &guy, const body_part_set &parts ) const
+{
 
     // reset all layer data
     vals = std::map<bodypart_id, encumbrance_data>();
@@ -929,25 +966,37 @@ void outfit::item_encumb( std::map<bodypart_id, encumbrance_data> &vals,
             const_cast<outfit *>( this )->position_to_wear_new_item( new_item );
     }
 
-    // Track highest layer observed so far so we can penalize out-of-order
-    // items
-    std::map<sub_bodypart_id, layer_level> highest_layer_so_far;
-
+    std::vector<layered_item> layered;
+    layered.reserve( worn.size() + 1 );
     for( auto w_it = worn.begin(); w_it != worn.end(); ++w_it ) {
         if( w_it == new_item_position ) {
-            layer_item( vals, new_item, highest_layer_so_far, guy );
+            layered.emplace_back( new_item );
         }
-        layer_item( vals, *w_it, highest_layer_so_far, guy );
+        layered.emplace_back( *w_it );
     }
 
     if( worn.end() == new_item_position && !new_item.is_null() ) {
-        layer_item( vals, new_item, highest_layer_so_far, guy );
+        layered.emplace_back( new_item );
     }
 
-    // make sure values are sane
+    // Items only conflict with the other items on the same body part, so each body part is
+    // layered on its own
     for( const bodypart_id &bp : guy.get_all_body_parts() ) {
+        if( !parts.test( bp.id() ) ) {
+            continue;
+        }
         encumbrance_data &elem = vals[bp];
 
+        // Track highest layer observed so far so we can penalize out-of-order
+        // items
+        std::vector<layer_level> highest_layer_so_far( bp->sub_parts.size(), layer_level::PERSONAL );
+        for( const layered_item &it : layered ) {
+            if( it.covered_parts.test( bp.id() ) ) {
+                layer_item( elem, it, bp, highest_layer_so_far, guy );
+            }
+        }
+
+        // make sure values are sane
         for( const layer_details &cur_layer : elem.layer_penalty_details ) {
             // only apply the layers penalty to the limb if it is conflicting
             if( cur_layer.is_conflicting ) {
@@ -1125,11 +1174,12 @@ int outfit::swim_modifier( const int swim_skill ) const
     return ret;
 }
 
-bool outfit::check_item_encumbrance_flag( bool update_required )
+bool outfit::check_item_encumbrance_flag( bool update_required, body_part_set &changed_parts )
 {
     for( item &i : worn ) {
-        if( !update_required && i.encumbrance_update_ ) {
+        if( i.encumbrance_update_ ) {
             update_required = true;
+            changed_parts.unify_set( i.get_covered_body_parts() );
         }
         i.encumbrance_update_ = false;
     }
@@ -1989,26 +2039,38 @@ int outfit::get_env_resist( bodypart_id bp ) const
 
 std::map<bodypart_id, int> outfit::warmth( const Character &guy ) const
 {
-    std::map<bodypart_id, int> total_warmth;
-    for( const bodypart_id &bp : guy.get_all_body_parts() ) {
-        double warmth_val = 0.0;
-        const float wetness_pct = guy.get_part_wetness_percentage( bp );
-        for( const item &clothing : worn ) {
-            if( !clothing.covers( bp ) ) {
+    const std::vector<bodypart_id> parts = guy.get_all_body_parts();
+    std::vector<float> wetness_pct;
+    wetness_pct.reserve( parts.size() );
+    for( const bodypart_id &bp : parts ) {
+        wetness_pct.push_back( guy.get_part_wetness_percentage( bp ) );
+    }
+    std::vector<int> total_warmth( parts.size(), 0 );
+    for( const item &clothing : worn ) {
+        const body_part_set covered_parts = clothing.get_covered_body_parts();
+        if( covered_parts.none() ) {
+            continue;
+        }
+        // Wool items do not lose their warmth due to being wet.
+        const bool wool = clothing.made_of( material_wool );
+        for( size_t i = 0; i < parts.size(); i++ ) {
+            if( !covered_parts.test( parts[i].id() ) ) {
                 continue;
             }
-            warmth_val = clothing.get_warmth( bp );
-            // Wool items do not lose their warmth due to being wet.
+            double warmth_val = clothing.get_warmth( parts[i] );
             // Warmth is reduced by 0 - 66% based on wetness.
-            if( !clothing.made_of( material_wool ) ) {
-                warmth_val *= 1.0 - 0.66 * wetness_pct;
+            if( !wool ) {
+                warmth_val *= 1.0 - 0.66 * wetness_pct[i];
             }
 
-            total_warmth[bp] += warmth_val;
+            total_warmth[i] += warmth_val;
         }
-        total_warmth[bp] += guy.get_effect_int( effect_heating_bionic, bp );
     }
-    return total_warmth;
+    std::map<bodypart_id, int> ret;
+    for( size_t i = 0; i < parts.size(); i++ ) {
+        ret.emplace( parts[i], total_warmth[i] + guy.get_effect_int( effect_heating_bionic, parts[i] ) );
+    }
+    return ret;
 }
 
 std::unordered_set<bodypart_id> outfit::where_discomfort( const Character &guy ) const
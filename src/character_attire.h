@@ -121,6 +121,9 @@ class outfit
          */
         void item_encumb( std::map<bodypart_id, encumbrance_data> &vals, const item &new_item,
                           const Character &guy ) const;
+        /** As above, but only for the body parts in @ref parts */
+        void item_encumb( std::map<bodypart_id, encumbrance_data> &vals, const item &new_item,
+                          const Character &guy, const body_part_set &parts ) const;
         std::list<item> get_visible_worn_items( const Character &guy ) const;
         int swim_modifier( int swim_skill ) const;
         bool natural_attack_restricted_on( const bodypart_id &bp ) const;
@@ -178,7 +181,12 @@ class outfit
         // concatenates to @overlay_ids
         void get_overlay_ids( std::vector<std::pair<std::string, std::string>> &overlay_ids ) const;
         body_part_set exclusive_flag_coverage( body_part_set bps, const flag_id &flag ) const;
-        bool check_item_encumbrance_flag( bool update_required );
+        /**
+         * Whether encumbrance has to be recalculated, because of @ref update_required or of the
+         * worn items flagged for it.  Clears the flags, adding the body parts the flagged items
+         * cover to @ref changed_parts.
+         */
+        bool check_item_encumbrance_flag( bool update_required, body_part_set &changed_parts );
         // creates a list of items dependent upon @it
         void add_dependent_item( std::list<item *> &dependent, const item &it );
         std::list<item> remove_worn_items_with( const std::function<bool( item & )> &filter,
@@ -252,6 +260,9 @@ class outfit
         const item &i_at( int position ) const;
 
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const;
+        /** Like @ref visit_items with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_items_inline( Visitor &func ) const;
         std::list<item> remove_items_with( Character &guy,
                                            const std::function<bool( const item & )> &filter, int &count );
 
@@ -44,6 +44,7 @@
 #include "ui.h"
 #include "units_fwd.h"
 #include "vehicle.h"
+#include "visitable-inl.h"
 #include "visitable.h"
 #include "vpart_position.h"
 
@@ -543,7 +544,7 @@ item *Character::invlet_to_item( const int linvlet ) const
                                       get_name();
     }
     item *invlet_item = nullptr;
-    visit_items( [&invlet, &invlet_item]( item * it, item * ) {
+    visit_items_inline( [&invlet, &invlet_item]( item * it, item * ) {
         if( it->invlet == invlet ) {
             invlet_item = it;
             return VisitResponse::ABORT;
@@ -628,7 +629,7 @@ invlets_bitset Character::allocated_invlets() const
 {
     invlets_bitset invlets = inv->allocated_invlets();
 
-    visit_items( [&invlets]( item * i, item * ) -> VisitResponse {
+    visit_items_inline( [&invlets]( item * i, item * ) -> VisitResponse {
         invlets.set( i->invlet );
         return VisitResponse::NEXT;
     } );
@@ -5,6 +5,7 @@
 #include <functional>
 #include <iosfwd>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <tuple>
 
@@ -108,7 +109,10 @@ void zone_manager::clear()
     removed_vzones.clear();
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
+    area_boxes.clear();
     vzone_cache.clear();
+    vzone_boxes.clear();
+    revision++;
 }
 
 std::string zone_type::name() const
@@ -414,6 +418,15 @@ std::string blueprint_options::get_zone_name_suggestion() const
     return _( "No construction" );
 }
 
+const std::function<bool( const item & )> &loot_options::get_filter() const
+{
+    if( !filter || filter_mark != mark ) {
+        filter = item_filter_from_string( mark );
+        filter_mark = mark;
+    }
+    return filter;
+}
+
 std::string loot_options::get_zone_name_suggestion() const
 {
     if( !mark.empty() ) {
@@ -851,9 +864,48 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
     return type_iter != area_cache.end();
 }
 
+zone_manager::zone_box zone_manager::make_box( const zone_data &zone )
+{
+    zone_box ret{ inclusive_cuboid<tripoint_abs_ms>( zone.get_start_point(), zone.get_end_point() ), nullptr };
+    if( zone.get_type() == zone_type_LOOT_CUSTOM ) {
+        ret.accepts = dynamic_cast<const loot_options &>( zone.get_options() ).get_filter();
+    } else if( zone.get_type() == zone_type_LOOT_ITEM_GROUP ) {
+        const item_group_id group( dynamic_cast<const loot_options &>( zone.get_options() ).get_mark() );
+        ret.accepts = [group]( const item & it ) {
+            return item_group::group_contains_item( group, it.typeId() );
+        };
+    }
+    return ret;
+}
+
+bool zone_manager::zone_box::accepts_item( const item *it ) const
+{
+    if( !accepts ) {
+        return true;
+    }
+    if( it == nullptr ) {
+        return false;
+    }
+    // same as custom_loot_has
+    const item *const check_it = it->this_or_single_content();
+    return accepts( *check_it ) || ( check_it != it && accepts( *it ) );
+}
+
+const std::vector<zone_manager::zone_box> &zone_manager::get_boxes( const zone_type_id &type,
+        const faction_id &fac, bool vehicle ) const
+{
+    static const std::vector<zone_box> none;
+    const std::unordered_map<std::string, std::vector<zone_box>> &boxes = vehicle ? vzone_boxes :
+            area_boxes;
+    const auto iter = boxes.find( zone_data::make_type_hash( type, fac ) );
+    return iter == boxes.end() ? none : iter->second;
+}
+
 void zone_manager::cache_data( bool update_avatar )
 {
+    revision++;
     area_cache.clear();
+    area_boxes.clear();
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.get_location();
     for( zone_data &elem : zones ) {
@@ -869,6 +921,7 @@ void zone_manager::cache_data( bool update_avatar )
 
         const std::string &type_hash = elem.get_type_hash();
         auto &cache = area_cache[type_hash];
+        area_boxes[type_hash].push_back( make_box( elem ) );
 
         // Draw marked area
         for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
@@ -896,6 +949,7 @@ void zone_manager::reset_disabled()
 
 void zone_manager::cache_avatar_location()
 {
+    revision++;
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.get_location();
     for( zone_data &elem : zones ) {
@@ -908,7 +962,9 @@ void zone_manager::cache_avatar_location()
 
 void zone_manager::cache_vzones( map *pmap )
 {
+    revision++;
     vzone_cache.clear();
+    vzone_boxes.clear();
     map &here = pmap == nullptr ? get_map() : *pmap;
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
     for( zone_data *elem : vzones ) {
@@ -918,6 +974,7 @@ void zone_manager::cache_vzones( map *pmap )
 
         const std::string &type_hash = elem->get_type_hash();
         auto &cache = vzone_cache[type_hash];
+        vzone_boxes[type_hash].push_back( make_box( *elem ) );
 
         // TODO: looks very similar to the above cache_data - maybe merge it?
 
@@ -929,17 +986,6 @@ void zone_manager::cache_vzones( map *pmap )
     }
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
-
-    return type_iter->second;
-}
-
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_abs_ms &where,
         int radius, const faction_id &fac ) const
 {
@@ -951,7 +997,7 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
 {
     std::unordered_set<tripoint> res;
     map &here = get_map();
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : area_cache ) {
+    for( const std::pair<const std::string, std::unordered_set<tripoint_abs_ms>> &cache : area_cache ) {
         zone_type_id type = zone_data::unhash_type( cache.first );
         faction_id z_fac = zone_data::unhash_fac( cache.first );
         if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
@@ -962,7 +1008,7 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
             }
         }
     }
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
+    for( const std::pair<const std::string, std::unordered_set<tripoint_abs_ms>> &cache : vzone_cache ) {
         zone_type_id type = zone_data::unhash_type( cache.first );
         faction_id z_fac = zone_data::unhash_fac( cache.first );
         if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
@@ -975,7 +1021,7 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
     }
 
     if( npc_search ) {
-        for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
+        for( const std::pair<const std::string, std::unordered_set<tripoint_abs_ms>> &cache : vzone_cache ) {
             zone_type_id type = zone_data::unhash_type( cache.first );
             if( type == zone_type_NO_NPC_PICKUP ) {
                 for( tripoint_abs_ms point : cache.second ) {
@@ -988,42 +1034,31 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
-
-    return type_iter->second;
-}
-
 bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    const auto contains = [&where]( const zone_box & zone ) {
+        return zone.box.contains( where );
+    };
+    const std::vector<zone_box> &boxes = get_boxes( type, fac, false );
+    const std::vector<zone_box> &vboxes = get_boxes( type, fac, true );
+    return std::any_of( boxes.begin(), boxes.end(), contains ) ||
+           std::any_of( vboxes.begin(), vboxes.end(), contains );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
+    for( const zone_box &zone : get_boxes( type, fac, false ) ) {
+        if( square_dist( clamp( where, zone.box ), where ) <= range ) {
             return true;
         }
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    for( const zone_box &zone : get_boxes( type, fac, true ) ) {
+        if( zone.box.p_min.z() <= where.z() && where.z() <= zone.box.p_max.z() &&
+            square_dist( clamp( where, zone.box ), where ) <= range ) {
+            return true;
         }
     }
 
@@ -1114,7 +1149,7 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
         std::string const filter_string = options.get_mark();
         bool has = false;
         if( ztype == zone_type_LOOT_CUSTOM ) {
-            auto const z = item_filter_from_string( filter_string );
+            const std::function<bool( const item & )> &z = options.get_filter();
             has = z( *check_it ) || ( check_it != it && z( *it ) );
         } else if( ztype == zone_type_LOOT_ITEM_GROUP ) {
             has = item_group::group_contains_item( item_group_id( filter_string ),
@@ -1131,34 +1166,70 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
     return false;
 }
 
+// The part of a zone within range of where, if any of it is
+static std::optional<inclusive_cuboid<tripoint_abs_ms>> near_part(
+            const inclusive_cuboid<tripoint_abs_ms> &zone, const tripoint_abs_ms &where, int range,
+            bool vehicle )
+{
+    const inclusive_cuboid<tripoint_abs_ms> near_box( where - tripoint( range, range, range ),
+            where + tripoint( range, range, range ) );
+    inclusive_cuboid<tripoint_abs_ms> part( clamp( zone.p_min, near_box ),
+                                            clamp( zone.p_max, near_box ) );
+    if( vehicle ) {
+        part.p_min.z() = where.z();
+        part.p_max.z() = where.z();
+    }
+    if( !zone.contains( part.p_min ) || !zone.contains( part.p_max ) ) {
+        return std::nullopt;
+    }
+    return part;
+}
+
 std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     std::unordered_set<tripoint_abs_ms> near_point_set;
 
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
+    const auto add_near = [&]( const std::vector<zone_box> &boxes, bool vehicle ) {
+        for( const zone_box &zone : boxes ) {
+            const std::optional<inclusive_cuboid<tripoint_abs_ms>> part =
+                near_part( zone.box, where, range, vehicle );
+            if( !part || !zone.accepts_item( it ) ) {
+                continue;
+            }
+            for( const tripoint_abs_ms &point : tripoint_range<tripoint_abs_ms>( part->p_min,
+                    part->p_max ) ) {
                 near_point_set.insert( point );
             }
         }
-    }
+    };
+    add_near( get_boxes( type, fac, false ), false );
+    add_near( get_boxes( type, fac, true ), true );
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                    ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
-                    near_point_set.insert( point );
-                }
+    return near_point_set;
+}
+
+std::vector<tripoint_abs_ms> zone_manager::get_near_parts( const tripoint_abs_ms &where,
+        int range, const faction_id &fac ) const
+{
+    std::vector<tripoint_abs_ms> parts;
+    const auto add_parts = [&]( const std::vector<zone_box> &boxes, bool vehicle ) {
+        for( const zone_box &zone : boxes ) {
+            if( const std::optional<inclusive_cuboid<tripoint_abs_ms>> part =
+                    near_part( zone.box, where, range, vehicle ) ) {
+                parts.push_back( part->p_min );
+                parts.push_back( part->p_max );
+            } else {
+                // can't be a corner of a part, so zones out of range can't be mistaken for parts
+                parts.emplace_back( tripoint_min );
             }
         }
+    };
+    for( const auto &type : types ) {
+        add_parts( get_boxes( type.first, fac, false ), false );
+        add_parts( get_boxes( type.first, fac, true ), true );
     }
-
-    return near_point_set;
+    return parts;
 }
 
 std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &type,
@@ -1170,29 +1241,18 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 
     tripoint_abs_ms nearest_pos( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    const auto find_nearest = [&]( const std::vector<zone_box> &boxes ) {
+        for( const zone_box &zone : boxes ) {
+            const tripoint_abs_ms p = clamp( where, zone.box );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
             }
         }
-    }
-
-    const std::unordered_set<tripoint_abs_ms> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
+    };
+    find_nearest( get_boxes( type, fac, false ) );
+    find_nearest( get_boxes( type, fac, true ) );
     if( nearest_dist > range ) {
         return std::nullopt;
     }
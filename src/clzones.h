@@ -255,11 +255,18 @@ class loot_options : public zone_options, public mark_option
 
         query_loot_result query_loot();
 
+        // @ref mark compiled by item_filter_from_string, and the mark it was compiled from
+        mutable std::function<bool( const item & )> filter; // NOLINT(cata-serialize)
+        mutable std::string filter_mark; // NOLINT(cata-serialize)
+
     public:
         std::string get_mark() const override {
             return mark;
         }
 
+        /** The item filter of @ref mark, compiled once instead of for every item checked. */
+        const std::function<bool( const item & )> &get_filter() const;
+
         void set_mark( std::string const &nmark ) {
             mark = nmark;
         }
@@ -531,14 +538,31 @@ class zone_manager
         // a count of the number of personal zones the character has
         int num_personal_zones = 0; // NOLINT(cata-serialize)
 
+        // changes whenever the cached zones do
+        int revision = 0; // NOLINT(cata-serialize)
+
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
+
+        // The extent of an enabled zone, cached next to its points in area_cache or vzone_cache.
+        // The queries about zones of a type check the few boxes of that type instead of all of
+        // the points in them.
+        struct zone_box {
+            inclusive_cuboid<tripoint_abs_ms> box;
+            // Whether the zone takes an item, only set for the zones that filter their items
+            std::function<bool( const item & )> accepts;
+
+            bool accepts_item( const item *it ) const;
+        };
+        static zone_box make_box( const zone_data &zone );
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, std::vector<zone_box>> area_boxes;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, std::vector<zone_box>> vzone_boxes;
+        const std::vector<zone_box> &get_boxes( const zone_type_id &type, const faction_id &fac,
+                                                bool vehicle ) const;
     public:
         zone_manager();
         ~zone_manager() = default;
@@ -580,6 +604,10 @@ class zone_manager
         bool has_type( const zone_type_id &type ) const;
         bool has_defined( const zone_type_id &type, const faction_id &fac = your_fac ) const;
         void cache_data( bool update_avatar = true );
+        /** Changes whenever the cached zones change, for caching what is derived from them. */
+        int get_revision() const {
+            return revision;
+        }
         void reset_disabled();
         void cache_avatar_location();
         void cache_vzones( map *pmap = nullptr );
@@ -596,6 +624,14 @@ class zone_manager
         std::unordered_set<tripoint_abs_ms> get_near(
             const zone_type_id &type, const tripoint_abs_ms &where, int range = MAX_DISTANCE,
             const item *it = nullptr, const faction_id &fac = your_fac ) const;
+        /**
+         * The parts of the zones of @p fac that are within @p range of @p where, each as its
+         * corners, in an order that only changes with the zones.  The queries about the zones
+         * near a place only look at these parts, so they answer the same for places that have
+         * the same parts near them.
+         */
+        std::vector<tripoint_abs_ms> get_near_parts( const tripoint_abs_ms &where, int range,
+                const faction_id &fac = your_fac ) const;
         std::optional<tripoint_abs_ms> get_nearest(
             const zone_type_id &type, const tripoint_abs_ms &where, int range = MAX_DISTANCE,
             const faction_id &fac = your_fac ) const;
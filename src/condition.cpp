@@ -375,7 +375,12 @@ tripoint_abs_ms get_tripoint_from_var( std::optional<var_info> var, dialogue con
 {
     tripoint_abs_ms target_pos = get_map().getglobal( d.actor( false )->pos() );
     if( var.has_value() ) {
-        std::string value = read_var_value( var.value(), d );
+        std::optional<var_value> const val = maybe_read_var( var.value(), d );
+        std::optional<tripoint_abs_ms> const pos = val ? val->tripoint() : std::nullopt;
+        if( pos ) {
+            return *pos;
+        }
+        std::string const value = val ? val->str() : var->default_val;
         if( !value.empty() ) {
             target_pos = tripoint_abs_ms( tripoint::from_string( value ) );
         }
@@ -474,37 +479,36 @@ translation_var_info read_translation_var_info( const JsonObject &jo )
     return abstract_read_var_info<translation>( jo );
 }
 
-void write_var_value( var_type type, const std::string &name, dialogue *d,
-                      const std::string &value, int call_depth )
+void write_var_value( var_type type, const var_key &key, dialogue *d, const var_value &value,
+                      int call_depth )
 {
     global_variables &globvars = get_globals();
     std::string ret;
     var_info vinfo( var_type::global, "" );
     switch( type ) {
         case var_type::global:
-            globvars.set_global_value( name, value );
+            globvars.set_global_value( key, value );
             break;
         case var_type::var:
-            ret = d->get_value( name );
+            ret = d->get_value( key.str() );
             vinfo = process_variable( ret );
             if( call_depth > 1000 ) {
                 debugmsg( "Possible infinite loop detected: var_val points to itself or forms a cycle.  %s->%s %s",
-                          name, vinfo.name, d->get_callstack() );
+                          key.str(), vinfo.name, d->get_callstack() );
             } else {
-                write_var_value( vinfo.type, vinfo.name, d, value,
-                                 call_depth + 1 );
+                write_var_value( vinfo.type, vinfo.key(), d, value, call_depth + 1 );
             }
             break;
         case var_type::u:
             if( d->has_alpha ) {
-                d->actor( false )->set_value( name, value );
+                d->actor( false )->set_var( key, value );
             } else {
                 debugmsg( "Tried to use an invalid alpha talker.  %s", d->get_callstack() );
             }
             break;
         case var_type::npc:
             if( d->has_beta ) {
-                d->actor( true )->set_value( name, value );
+                d->actor( true )->set_var( key, value );
             } else {
                 debugmsg( "Tried to use an invalid beta talker.  %s", d->get_callstack() );
             }
@@ -516,7 +520,7 @@ void write_var_value( var_type type, const std::string &name, dialogue *d,
             debugmsg( "Not implemented yet." );
             break;
         case var_type::context:
-            d->set_value( name, value );
+            d->set_value( key.str(), value.str() );
             break;
         default:
             debugmsg( "Invalid type." );
@@ -524,11 +528,16 @@ void write_var_value( var_type type, const std::string &name, dialogue *d,
     }
 }
 
+void write_var_value( var_type type, const std::string &name, dialogue *d,
+                      const std::string &value, int call_depth )
+{
+    write_var_value( type, var_key( name ), d, var_value( value ), call_depth );
+}
+
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       double value )
 {
-    // NOLINTNEXTLINE(cata-translate-string-literal)
-    write_var_value( type, name, d, string_format( "%g", value ) );
+    write_var_value( type, var_key( name ), d, var_value( value ) );
 }
 
 static bodypart_id get_bp_from_str( const std::string &ctxt )
@@ -62,6 +62,8 @@ duration_or_var_part get_duration_or_var_part( const JsonValue &jv, const std::s
 tripoint_abs_ms get_tripoint_from_var( std::optional<var_info> var, dialogue const &d );
 var_info read_var_info( const JsonObject &jo );
 translation_var_info read_translation_var_info( const JsonObject &jo );
+void write_var_value( var_type type, const var_key &key, dialogue *d, const var_value &value,
+                      int call_depth = 0 );
 void write_var_value( var_type type, const std::string &name, dialogue *d,
                       const std::string &value, int call_depth = 0 );
 void write_var_value( var_type type, const std::string &name, dialogue *d,
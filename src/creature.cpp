@@ -39,6 +39,7 @@
 #include "flexbuffer_json.h"
 #include "game.h"
 #include "game_constants.h"
+#include "global_vars.h"
 #include "item.h"
 #include "item_location.h"
 #include "json_error.h"
@@ -1944,12 +1945,17 @@ bool Creature::has_trait( const trait_id &/*flag*/ ) const
 // Methods for setting/getting misc key/value pairs.
 void Creature::set_value( const std::string &key, const std::string &value )
 {
-    values[ key ] = value;
+    values->set( var_key( key ), var_value( value ) );
+}
+
+void Creature::set_value( const var_key &key, var_value value )
+{
+    values->set( key, std::move( value ) );
 }
 
 void Creature::remove_value( const std::string &key )
 {
-    values.erase( key );
+    values->erase( key );
 }
 
 std::string Creature::get_value( const std::string &key ) const
@@ -1959,13 +1965,18 @@ std::string Creature::get_value( const std::string &key ) const
 
 std::optional<std::string> Creature::maybe_get_value( const std::string &key ) const
 {
-    auto it = values.find( key );
-    return it == values.end() ? std::nullopt : std::optional<std::string> { it->second };
+    const var_value *val = values->find( key );
+    return val == nullptr ? std::nullopt : std::optional<std::string> { val->str() };
+}
+
+const var_value *Creature::get_var( const var_key &key ) const
+{
+    return values->find( key );
 }
 
 void Creature::clear_values()
 {
-    values.clear();
+    values->clear();
 }
 
 void Creature::mod_pain( int npain )
@@ -2996,9 +3007,9 @@ bool Creature::is_symbol_highlighted() const
     return false;
 }
 
-std::unordered_map<std::string, std::string> &Creature::get_values()
+const var_store &Creature::get_values() const
 {
-    return values;
+    return *values;
 }
 
 bodypart_id Creature::get_max_hitsize_bodypart() const
@@ -100,6 +100,7 @@
 #include "pimpl.h"
 #include "point.h"
 #include "popup.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "relic.h"
 #include "requirements.h"
@@ -227,6 +228,8 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::QUICKLOAD: return "QUICKLOAD";
         case debug_menu::debug_menu_index::TEST_WEATHER: return "TEST_WEATHER";
         case debug_menu::debug_menu_index::WRITE_GLOBAL_EOCS: return "WRITE_GLOBAL_EOCS";
+        case debug_menu::debug_menu_index::WRITE_EOC_STATS: return "WRITE_EOC_STATS";
+        case debug_menu::debug_menu_index::PROFILER: return "PROFILER";
         case debug_menu::debug_menu_index::WRITE_GLOBAL_VARS: return "WRITE_GLOBAL_VARS";
         case debug_menu::debug_menu_index::EDIT_GLOBAL_VARS: return "SET_GLOBAL_VARS";
         case debug_menu::debug_menu_index::WRITE_TIMED_EVENTS: return "WRITE_TIMED_EVENTS";
@@ -493,6 +496,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( debug_menu_index::PROFILER, true, 'P', _( "Hot path profiler" ) ) },
             { uilist_entry( debug_menu_index::HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
@@ -501,6 +505,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::PRINT_NPC_MAGIC, true, 'M', _( "Print NPC magic info to console" ) ) },
             { uilist_entry( debug_menu_index::TEST_WEATHER, true, 'W', _( "Test weather" ) ) },
             { uilist_entry( debug_menu_index::WRITE_GLOBAL_EOCS, true, 'C', _( "Write global effect_on_condition(s) to eocs.output" ) ) },
+            { uilist_entry( debug_menu_index::WRITE_EOC_STATS, true, 'O', _( "Show queued effect_on_condition timings, kept while profiling" ) ) },
             { uilist_entry( debug_menu_index::WRITE_GLOBAL_VARS, true, 'G', _( "Write global var(s) to var_list.output" ) ) },
             { uilist_entry( debug_menu_index::WRITE_TIMED_EVENTS, true, 'E', _( "Write Timed (E)vents to timed_event_list.output" ) ) },
             { uilist_entry( debug_menu_index::EDIT_GLOBAL_VARS, true, 'a', _( "Edit global v(a)rs" ) ) },
@@ -1444,6 +1449,101 @@ static void spawn_nested_mapgen()
     }
 }
 
+static void profiler_menu()
+{
+    enum {
+        D_PROFILER_TOGGLE, D_PROFILER_TRACE, D_PROFILER_SHOW, D_PROFILER_EXPORT, D_PROFILER_TURNS,
+        D_PROFILER_TURNS_CSV, D_PROFILER_RESET
+    };
+    uilist pmenu;
+    pmenu.text = _( "Time spent per effect_on_condition, activity, monster special attack, field and active item" );
+#if defined(CATA_NO_PROFILER)
+    pmenu.text += _( "\nThe profiler was compiled out of this build." );
+#endif
+    pmenu.addentry( D_PROFILER_TOGGLE, true, 'c', profiler::counting ? _( "Stop counting" ) :
+                    _( "Start counting" ) );
+    pmenu.addentry( D_PROFILER_TRACE, true, 't', profiler::tracing() ? _( "Stop tracing" ) :
+                    _( "Start counting and tracing" ) );
+    pmenu.addentry( D_PROFILER_SHOW, true, 's', _( "Show the most expensive ids" ) );
+    pmenu.addentry( D_PROFILER_EXPORT, true, 'e',
+                    _( "Write the trace to profile_trace.json" ) );
+    pmenu.addentry( D_PROFILER_TURNS, true, 'p', _( "Show the time spent in each phase of the turn" ) );
+    pmenu.addentry( D_PROFILER_TURNS_CSV, true, 'w',
+                    _( "Write the last turns to turn_profile.csv" ) );
+    pmenu.addentry( D_PROFILER_RESET, true, 'r', _( "Reset counters and trace" ) );
+    pmenu.query();
+    switch( pmenu.ret ) {
+        case D_PROFILER_TOGGLE:
+            profiler::set_enabled( !profiler::counting, false );
+            break;
+        case D_PROFILER_TRACE:
+            profiler::set_enabled( true, !profiler::tracing() );
+            break;
+        case D_PROFILER_SHOW: {
+            const auto new_win = []() {
+                return catacurses::newwin( TERMY, TERMX, point_zero );
+            };
+            scrollable_text( new_win, _( "Hot path profiler" ), profiler::summary( 200 ) );
+            break;
+        }
+        case D_PROFILER_EXPORT:
+            if( profiler::write_chrome_trace( "profile_trace.json" ) ) {
+                popup( _( "Trace written to profile_trace.json" ) );
+            }
+            break;
+        case D_PROFILER_TURNS: {
+            const auto new_win = []() {
+                return catacurses::newwin( TERMY, TERMX, point_zero );
+            };
+            scrollable_text( new_win, _( "Turn phases" ), profiler::turn_summary() );
+            break;
+        }
+        case D_PROFILER_TURNS_CSV:
+            if( profiler::write_turn_window_csv( "turn_profile.csv" ) ) {
+                popup( _( "Turn profile written to turn_profile.csv" ) );
+            }
+            break;
+        case D_PROFILER_RESET:
+            profiler::reset();
+            break;
+        default:
+            break;
+    }
+}
+
+static void queued_eoc_stats_menu()
+{
+    enum {
+        D_EOC_STATS_WRITE, D_EOC_STATS_RESET, D_EOC_STATS_FIRST
+    };
+    const std::vector<std::pair<effect_on_condition_id, queued_eoc_stats>> sorted =
+        effect_on_conditions::sorted_queued_stats();
+    uilist smenu;
+    smenu.title = _( "Queued effect_on_conditions, most expensive first" );
+    smenu.text = _( "Only kept while the profiler is counting." );
+    smenu.desc_enabled = true;
+    smenu.addentry( D_EOC_STATS_WRITE, true, 'w', _( "Write them to eoc_stats.output" ) );
+    smenu.addentry( D_EOC_STATS_RESET, true, 'r', _( "Reset them" ) );
+    for( size_t i = 0; i < sorted.size(); i++ ) {
+        const queued_eoc_stats &stats = sorted[i].second;
+        const double total_us = std::chrono::duration<double, std::micro>( stats.time ).count();
+        smenu.addentry_desc( D_EOC_STATS_FIRST + static_cast<int>( i ), true, MENU_AUTOASSIGN,
+                             string_format( _( "%s  %.2f ms" ), sorted[i].first.str(), total_us / 1000.0 ),
+                             string_format( _( "Fired %d times, activated %d times.  %.1f us on average." ),
+                                            stats.fired, stats.activated, total_us / std::max( stats.fired, 1 ) ) );
+    }
+    do {
+        smenu.query();
+        if( smenu.ret == D_EOC_STATS_WRITE ) {
+            effect_on_conditions::write_queued_stats_to_file();
+            popup( _( "effect_on_condition timings written to eoc_stats.output" ) );
+        } else if( smenu.ret == D_EOC_STATS_RESET ) {
+            effect_on_conditions::reset_queued_stats();
+            return;
+        }
+    } while( smenu.ret != UILIST_CANCEL );
+}
+
 static void control_npc_menu()
 {
     get_avatar().control_npc_menu( true );
@@ -2240,7 +2340,7 @@ static void character_edit_menu()
                 testfile << "|;key;value;" << std::endl;
 
                 for( const auto &value : you.get_values() ) {
-                    testfile << "|;" << value.first << ";" << value.second << ";" << std::endl;
+                    testfile << "|;" << value.first.str() << ";" << value.second.str() << ";" << std::endl;
                 }
 
             }, "var_list" );
@@ -3490,6 +3590,12 @@ void debug()
             popup( _( "effect_on_condition list written to eocs.output" ) );
         }
         break;
+        case debug_menu_index::PROFILER:
+            profiler_menu();
+            break;
+        case debug_menu_index::WRITE_EOC_STATS:
+            queued_eoc_stats_menu();
+            break;
         case debug_menu_index::WRITE_GLOBAL_VARS: {
             write_to_file( "var_list.output", [&]( std::ostream & testfile ) {
                 testfile << "Global" << std::endl;
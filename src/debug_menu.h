@@ -90,6 +90,8 @@ enum class debug_menu_index : int {
     VEHICLE_EXPORT,
     GENERATE_EFFECT_LIST,
     WRITE_GLOBAL_EOCS,
+    WRITE_EOC_STATS,
+    PROFILER,
     WRITE_GLOBAL_VARS,
     EDIT_GLOBAL_VARS,
     ACTIVATE_EOC,
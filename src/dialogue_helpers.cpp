@@ -1,25 +1,29 @@
 #include "dialogue_helpers.h"
 
 #include <string>
+#include <utility>
 
 #include "dialogue.h"
 #include "rng.h"
 #include "talker.h"
 
 template<class T>
-std::optional<std::string> maybe_read_var_value(
-    const abstract_var_info<T> &info, const dialogue &d, int call_depth )
+std::optional<var_value> maybe_read_var( const abstract_var_info<T> &info, const dialogue &d,
+        int call_depth )
 {
-    global_variables &globvars = get_globals();
     switch( info.type ) {
-        case var_type::global:
-            return globvars.maybe_get_global_value( info.name );
-        case var_type::context:
-            return d.maybe_get_value( info.name );
+        case var_type::global: {
+            const var_value *val = get_globals().get_global( info.key() );
+            return val == nullptr ? std::nullopt : std::optional<var_value> { *val };
+        }
+        case var_type::context: {
+            std::optional<std::string> const val = d.maybe_get_value( info.name );
+            return val ? std::optional<var_value>( var_value( *val ) ) : std::nullopt;
+        }
         case var_type::u:
-            return d.actor( false )->maybe_get_value( info.name );
+            return d.actor( false )->maybe_get_var( info.key() );
         case var_type::npc:
-            return d.actor( true )->maybe_get_value( info.name );
+            return d.actor( true )->maybe_get_var( info.key() );
         case var_type::var: {
             std::optional<std::string> const var_val = d.maybe_get_value( info.name );
             if( call_depth > 1000 && var_val ) {
@@ -27,8 +31,9 @@ std::optional<std::string> maybe_read_var_value(
                           info.name, var_val.value(), d.get_callstack() );
                 return std::nullopt;
             } else {
-                return var_val ? maybe_read_var_value( process_variable( *var_val ), d,
-                                                       call_depth + 1 ) : std::nullopt;
+                const std::optional<var_info> target = var_val ? find_variable( *var_val ) :
+                                                       std::nullopt;
+                return target ? maybe_read_var( *target, d, call_depth + 1 ) : std::nullopt;
             }
         }
         case var_type::faction:
@@ -39,6 +44,20 @@ std::optional<std::string> maybe_read_var_value(
     return std::nullopt;
 }
 
+template
+std::optional<var_value> maybe_read_var( const var_info &, const dialogue &, int call_depth );
+template
+std::optional<var_value> maybe_read_var( const translation_var_info &, const dialogue &,
+        int call_depth );
+
+template<class T>
+std::optional<std::string> maybe_read_var_value(
+    const abstract_var_info<T> &info, const dialogue &d, int call_depth )
+{
+    std::optional<var_value> const val = maybe_read_var( info, d, call_depth );
+    return val ? std::optional<std::string>( val->str() ) : std::nullopt;
+}
+
 template
 std::optional<std::string> maybe_read_var_value( const var_info &, const dialogue &,
         int call_depth );
@@ -58,7 +77,7 @@ std::string read_var_value( const translation_var_info &info, const dialogue &d
     return maybe_read_var_value( info, d ).value_or( info.default_val.translated() );
 }
 
-var_info process_variable( const std::string &type )
+static std::pair<var_type, std::string> split_variable( const std::string &type )
 {
     var_type vt = var_type::global;
     std::string ret_str = type;
@@ -89,7 +108,26 @@ var_info process_variable( const std::string &type )
         ret_str = type.substr( 1, type.size() - 1 );
     }
 
-    return var_info( vt, "npctalk_var_" + ret_str );
+    return { vt, "npctalk_var_" + ret_str };
+}
+
+var_info process_variable( const std::string &type )
+{
+    std::pair<var_type, std::string> split = split_variable( type );
+    return var_info( split.first, std::move( split.second ) );
+}
+
+std::optional<var_info> find_variable( const std::string &type )
+{
+    std::pair<var_type, std::string> split = split_variable( type );
+    if( split.first == var_type::context || split.first == var_type::var ) {
+        return var_info( split.first, std::move( split.second ), var_key() );
+    }
+    const std::optional<var_key> key = var_key::find( split.second );
+    if( !key ) {
+        return std::nullopt;
+    }
+    return var_info( split.first, std::move( split.second ), *key );
 }
 
 template<>
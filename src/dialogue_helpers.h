@@ -32,13 +32,25 @@ struct dbl_or_var;
 template<class T>
 struct abstract_var_info {
     abstract_var_info( var_type in_type, std::string in_name ): type( in_type ),
-        name( std::move( in_name ) ) {}
+        name( std::move( in_name ) ), key_( name ) {}
     abstract_var_info( var_type in_type, std::string in_name, T in_default_val ): type( in_type ),
-        name( std::move( in_name ) ), default_val( std::move( in_default_val ) ) {}
+        name( std::move( in_name ) ), default_val( std::move( in_default_val ) ), key_( name ) {}
+    // for a name that is already interned
+    abstract_var_info( var_type in_type, std::string in_name, const var_key &in_key ):
+        type( in_type ), name( std::move( in_name ) ), key_( in_key ) {}
     abstract_var_info() : type( var_type::global ) {}
     var_type type;
     std::string name;
     T default_val;
+
+    // interned name, interned when the variable is loaded so that reads never intern names
+    // not used for the context and var types, which are looked up by name
+    const var_key &key() const {
+        return key_;
+    }
+
+    private:
+        var_key key_;
 };
 
 using var_info = abstract_var_info<std::string>;
@@ -92,8 +104,15 @@ std::string read_var_value( const abstract_var_info<T> &info, const dialogue &d
 template<class T>
 std::optional<std::string> maybe_read_var_value(
     const abstract_var_info<T> &info, const dialogue &d, int call_depth = 0 );
+// like maybe_read_var_value, but without converting the value to a string
+template<class T>
+std::optional<var_value> maybe_read_var( const abstract_var_info<T> &info, const dialogue &d,
+        int call_depth = 0 );
 
 var_info process_variable( const std::string &type );
+// like process_variable, but doesn't intern the name
+// nullopt for a variable that can't have been set, since its name was never interned
+std::optional<var_info> find_variable( const std::string &type );
 
 struct eoc_math {
     enum class oper : int {
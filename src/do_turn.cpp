@@ -57,6 +57,7 @@
 #include "player_activity.h"
 #include "point.h"
 #include "popup.h"
+#include "profiler.h"
 #include "rng.h"
 #include "scent_map.h"
 #include "sdlsound.h"
@@ -386,7 +387,44 @@ void monmove()
     g->cleanup_dead();
 }
 
-void overmap_npc_move()
+// Moves the NPC along its travel path by one overmap tile, finding the path first if needed.
+// Finding the path doesn't use up the step, so the NPC only stays put once its goal turns out
+// to be reached or unreachable, and then the goal is reset.
+static void travel_one_step( npc &guy )
+{
+    if( !guy.omt_path.empty() ) {
+        if( rl_dist( guy.omt_path.back(), guy.global_omt_location() ) > 2 ) {
+            // recalculate path, we got distracted doing something else probably
+            guy.omt_path.clear();
+        } else if( guy.omt_path.back() == guy.global_omt_location() ) {
+            guy.omt_path.pop_back();
+        }
+    }
+    if( guy.omt_path.empty() ) {
+        guy.omt_path = overmap_buffer.get_travel_path( guy.global_omt_location(), guy.goal,
+                       overmap_path_params::for_npc() );
+        // The path starts where the NPC already is
+        if( !guy.omt_path.empty() && guy.omt_path.back() == guy.global_omt_location() ) {
+            guy.omt_path.pop_back();
+        }
+        if( guy.omt_path.empty() ) { // goal is unreachable, or already reached goal, reset it
+            guy.goal = npc::no_goal_point;
+            return;
+        }
+    }
+    guy.travel_overmap( guy.omt_path.back() );
+}
+
+// Travelling NPCs farther than this from the player (in submaps) can't get into the reality
+// bubble before their next step, so they are moved less often by several tiles at a time.
+static constexpr int npc_fine_travel_range = 2 * MAPSIZE;
+static constexpr time_duration npc_coarse_travel_interval = 30_minutes;
+// One tile every five minutes, like the NPCs near the player
+static constexpr int npc_coarse_travel_steps = 6;
+
+} // namespace
+
+bool overmap_npc_move()
 {
     avatar &u = get_avatar();
     std::vector<npc *> travelling_npcs;
@@ -401,27 +439,28 @@ void overmap_npc_move()
             travelling_npcs.push_back( npc_to_add );
         }
     }
+    const bool coarse_step = calendar::once_every( npc_coarse_travel_interval );
+    const point_abs_sm player_sm = u.global_sm_location().xy();
+    const point_abs_sm abs_sub = get_map().get_abs_sub().xy();
+    const half_open_rectangle<point_abs_sm> map_bounds( abs_sub, abs_sub + point( MAPSIZE,
+            MAPSIZE ) );
     bool npcs_need_reload = false;
     for( npc *&elem : travelling_npcs ) {
-        if( elem->has_omt_destination() ) {
-            if( !elem->omt_path.empty() ) {
-                if( rl_dist( elem->omt_path.back(), elem->global_omt_location() ) > 2 ) {
-                    // recalculate path, we got distracted doing something else probably
-                    elem->omt_path.clear();
-                } else if( elem->omt_path.back() == elem->global_omt_location() ) {
-                    elem->omt_path.pop_back();
-                }
-            }
-            if( elem->omt_path.empty() ) {
-                elem->omt_path = overmap_buffer.get_travel_path( elem->global_omt_location(), elem->goal,
-                                 overmap_path_params::for_npc() );
-                if( elem->omt_path.empty() ) { // goal is unreachable, or already reached goal, reset it
-                    elem->goal = npc::no_goal_point;
-                }
-            } else {
-                elem->travel_overmap( elem->omt_path.back() );
-                npcs_need_reload = true;
-            }
+        const bool near = square_dist( player_sm, elem->global_sm_location().xy() ) <=
+                          npc_fine_travel_range;
+        if( !near && !coarse_step ) {
+            continue;
+        }
+        const bool was_active = elem->is_active();
+        const tripoint_abs_omt old_pos = elem->global_omt_location();
+        const int steps = near ? 1 : npc_coarse_travel_steps;
+        for( int i = 0; i < steps && elem->has_omt_destination(); i++ ) {
+            travel_one_step( *elem );
+        }
+        // Only NPCs that left or entered the reality bubble need it reloaded
+        if( elem->global_omt_location() != old_pos &&
+            ( was_active || map_bounds.contains( elem->global_sm_location().xy() ) ) ) {
+            npcs_need_reload = true;
         }
         if( !elem->has_omt_destination() && calendar::once_every( 1_hours ) && one_in( 3 ) ) {
             // travelling destination is reached/not set, try different one
@@ -431,10 +470,9 @@ void overmap_npc_move()
     if( npcs_need_reload ) {
         g->reload_npcs();
     }
+    return npcs_need_reload;
 }
 
-} // namespace
-
 // MAIN GAME LOOP
 // Returns true if game is over (death, saved, quit, etc)
 bool do_turn()
@@ -456,7 +494,9 @@ bool do_turn()
             weather.set_nextweather( calendar::turn );
         }
     } else {
-        g->gamemode->per_turn();
+        if( g->gamemode ) {
+            g->gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
 
@@ -469,9 +509,12 @@ bool do_turn()
         g->load_npcs();
     }
 
-    timed_event_manager &timed_events = get_timed_events();
-    timed_events.process();
-    mission::process_all();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::timed_events );
+        timed_event_manager &timed_events = get_timed_events();
+        timed_events.process();
+        mission::process_all();
+    }
     avatar &u = get_avatar();
     map &m = get_map();
     // If controlling a vehicle that is owned by someone else
@@ -495,11 +538,13 @@ bool do_turn()
         u.check_mount_is_spooked();
     }
     if( calendar::once_every( 1_days ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::hordes );
         overmap_buffer.process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::hordes );
 
         if( get_option<bool>( "WANDER_SPAWNS" ) ) {
             overmap_buffer.move_hordes();
@@ -514,38 +559,54 @@ bool do_turn()
 
     g->debug_hour_timer.print_time();
 
-    u.update_body();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::player_body );
+        u.update_body();
+    }
 
     // Auto-save if autosave is enabled
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::autosave );
         g->autosave();
     }
 
-    weather.update_weather();
-    g->reset_light_level();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::weather );
+        weather.update_weather();
+        g->reset_light_level();
+    }
 
-    g->perhaps_add_random_npc( /* ignore_spawn_timers_and_rates = */ false );
-    while( u.get_moves() > 0 && u.activity ) {
-        u.activity.do_turn( u );
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::npc_spawn );
+        g->perhaps_add_random_npc( /* ignore_spawn_timers_and_rates = */ false );
+    }
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::player_activity );
+        while( u.get_moves() > 0 && u.activity ) {
+            u.activity.do_turn( u );
+        }
     }
     // FIXME: hack needed due to the legacy code in advanced_inventory::move_all_items()
     if( !u.activity ) {
         kill_advanced_inv();
     }
 
-    // Process NPC sound events before they move or they hear themselves talking
-    for( npc &guy : g->all_npcs() ) {
-        if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
-            sounds::process_sound_markers( &guy );
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::sound_markers );
+        // Process NPC sound events before they move or they hear themselves talking
+        for( npc &guy : g->all_npcs() ) {
+            if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
+                sounds::process_sound_markers( &guy );
+            }
         }
-    }
 
-    music::deactivate_music_id( music::music_id::sound );
+        music::deactivate_music_id( music::music_id::sound );
 
-    // Process sound events into sound markers for display to the player.
-    sounds::process_sound_markers( &u );
+        // Process sound events into sound markers for display to the player.
+        sounds::process_sound_markers( &u );
+    }
 
     if( u.is_deaf() ) {
         sfx::do_hearing_loss();
@@ -629,35 +690,64 @@ bool do_turn()
         g->calc_driving_offset( veh );
     }
 
-    scent_map &scent = get_scent();
-    // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
-        scent.set( u.pos(), u.scent, u.get_type_of_scent() );
-        overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::scent );
+        scent_map &scent = get_scent();
+        // No-scent debug mutation has to be processed here or else it takes time to start working
+        if( !u.has_flag( STATIC( json_character_flag( "NO_SCENT" ) ) ) ) {
+            scent.set( u.pos(), u.scent, u.get_type_of_scent() );
+            overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+        }
+        scent.update( u.pos(), m );
     }
-    scent.update( u.pos(), m );
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::floor_caches );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
-    explosion_handler::process_explosions();
-    m.creature_in_field( u );
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::vehicles );
+        m.process_falling();
+        m.vehmove();
+    }
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::fields );
+        m.process_fields();
+    }
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::items );
+        m.process_items();
+    }
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::explosions );
+        explosion_handler::process_explosions();
+        m.creature_in_field( u );
+    }
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
     const int levz = m.get_abs_sub().z();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
-    monmove();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( levz, true );
+    }
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::monsters );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::npc_overmap );
         overmap_npc_move();
     }
     if( calendar::once_every( 10_seconds ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::emissions );
         for( const tripoint &elem : m.get_furn_field_locations() ) {
             const furn_t &furn = *m.furn( elem );
             for( const emit_id &e : furn.emissions ) {
@@ -671,14 +761,19 @@ bool do_turn()
             }
         }
     }
-    g->mon_info_update();
-    u.process_turn();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::player_turn );
+        g->mon_info_update();
+        u.process_turn();
+    }
     if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::redraw );
         ui_manager::redraw();
         refresh_display();
     }
 
     if( levz >= 0 && !u.is_underwater() ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::weather );
         handle_weather_effects( weather.weather_id );
     }
 
@@ -705,6 +800,7 @@ bool do_turn()
         }
     }
     if( wait_redraw ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::redraw );
         if( g->first_redraw_since_waiting_started ||
             calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) ) {
             if( g->first_redraw_since_waiting_started || calendar::once_every( wait_refresh_rate ) ) {
@@ -727,11 +823,15 @@ bool do_turn()
 
     m.invalidate_visibility_cache();
 
-    u.update_bodytemp();
-    u.update_body_wetness( *weather.weather_precise );
-    u.apply_wetness_morale( weather.temperature );
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::body_temperature );
+        u.update_bodytemp();
+        u.update_body_wetness( *weather.weather_precise );
+        u.apply_wetness_morale( weather.temperature );
+    }
 
     if( calendar::once_every( 1_minutes ) ) {
+        profiler::turn_phase_scope phase( profiler::turn_phase::morale );
         u.update_morale();
         for( npc &guy : g->all_npcs() ) {
             guy.update_morale();
@@ -743,13 +843,16 @@ bool do_turn()
         u.check_and_recover_morale();
     }
 
-    if( !u.is_deaf() ) {
-        sfx::remove_hearing_loss();
+    {
+        profiler::turn_phase_scope phase( profiler::turn_phase::sfx );
+        if( !u.is_deaf() ) {
+            sfx::remove_hearing_loss();
+        }
+        sfx::do_danger_music();
+        sfx::do_vehicle_engine_sfx();
+        sfx::do_vehicle_exterior_engine_sfx();
+        sfx::do_sleepiness();
     }
-    sfx::do_danger_music();
-    sfx::do_vehicle_engine_sfx();
-    sfx::do_vehicle_exterior_engine_sfx();
-    sfx::do_sleepiness();
 
     // reset player noise
     u.volume = 0;
@@ -758,6 +861,8 @@ bool do_turn()
     u.power_balance = u.get_power_level() - u.power_prev_turn;
     u.power_prev_turn = u.get_power_level();
 
+    profiler::end_turn( to_turn<int>( calendar::turn ) );
+
 #if defined(EMSCRIPTEN)
     // This will cause a prompt to be shown if the window is closed, until the
     // game is saved.
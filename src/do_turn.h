@@ -5,5 +5,11 @@
 /** MAIN GAME LOOP. Returns true if game is over (death, saved, quit, etc.). */
 bool do_turn();
 void handle_key_blocking_activity();
+/**
+ * Moves the NPCs travelling across the overmap, called every five minutes.  Those far from the
+ * player only move every half hour, several tiles at a time.
+ * @returns whether the NPCs in the reality bubble were reloaded, because one entered or left it.
+ */
+bool overmap_npc_move();
 
 #endif // CATA_SRC_DO_TURN_H
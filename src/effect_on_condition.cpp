@@ -1,10 +1,12 @@
 #include "effect_on_condition.h"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <ostream>
-#include <queue>
 #include <set>
 
 #include "avatar.h"
@@ -24,6 +26,7 @@
 #include "mod_tracker.h"
 #include "npc.h"
 #include "output.h"
+#include "profiler.h"
 #include "scenario.h"
 #include "string_formatter.h"
 #include "talker.h"
@@ -137,6 +140,174 @@ static time_duration next_recurrence( const effect_on_condition_id &eoc, dialogu
     return eoc->recurrence.evaluate( d );
 }
 
+queued_eocs::queued_eocs( const queued_eocs &rhs ) : list( rhs.list )
+{
+    rebuild( rhs.wheel_time );
+}
+
+queued_eocs::queued_eocs( queued_eocs &&rhs ) noexcept
+{
+    swap( rhs );
+}
+
+queued_eocs &queued_eocs::operator=( const queued_eocs &rhs )
+{
+    if( this != &rhs ) {
+        list = rhs.list;
+        rebuild( rhs.wheel_time );
+    }
+    return *this;
+}
+
+queued_eocs &queued_eocs::operator=( queued_eocs &&rhs ) noexcept
+{
+    swap( rhs );
+    return *this;
+}
+
+void queued_eocs::swap( queued_eocs &rhs ) noexcept
+{
+    list.swap( rhs.list );
+    wheel.swap( rhs.wheel );
+    level_size.swap( rhs.level_size );
+    overflow.swap( rhs.overflow );
+    due_now.swap( rhs.due_now );
+    std::swap( wheel_time, rhs.wheel_time );
+}
+
+void queued_eocs::push( const queued_eoc &eoc )
+{
+    schedule( list.emplace( list.end(), eoc ) );
+}
+
+void queued_eocs::clear()
+{
+    list.clear();
+    rebuild( calendar::turn );
+}
+
+void queued_eocs::remove_if( const std::function<bool( const queued_eoc & )> &pred )
+{
+    list.remove_if( pred );
+    rebuild( wheel_time );
+}
+
+std::vector<const queued_eoc *> queued_eocs::sorted() const
+{
+    std::vector<const queued_eoc *> ret;
+    ret.reserve( list.size() );
+    for( const queued_eoc &eoc : list ) {
+        ret.push_back( &eoc );
+    }
+    std::stable_sort( ret.begin(), ret.end(), []( const queued_eoc * lhs, const queued_eoc * rhs ) {
+        return lhs->time < rhs->time;
+    } );
+    return ret;
+}
+
+void queued_eocs::rebuild( const time_point &now )
+{
+    for( std::array<std::vector<storage_iter>, wheel_slots> &level : wheel ) {
+        for( std::vector<storage_iter> &slot : level ) {
+            slot.clear();
+        }
+    }
+    level_size.fill( 0 );
+    overflow.clear();
+    due_now.clear();
+    wheel_time = now;
+    for( auto it = list.begin(); it != list.end(); ++it ) {
+        place( it );
+    }
+}
+
+void queued_eocs::schedule( storage_iter it )
+{
+    if( overflow.empty() && due_now.empty() &&
+        std::all_of( level_size.begin(), level_size.end(), []( int size ) {
+        return size == 0;
+    } ) ) {
+        // Nothing is scheduled, so there is nothing to advance past on the way to the present
+        wheel_time = calendar::turn;
+    }
+    place( it );
+}
+
+void queued_eocs::place( storage_iter it )
+{
+    const int64_t now = to_turn<int>( wheel_time );
+    const int64_t due = to_turn<int>( it->time );
+    if( due <= now ) {
+        due_now.push_back( it );
+        return;
+    }
+    // Use the finest level whose current rotation still reaches the turn it is due
+    for( int level = 0; level < wheel_levels; level++ ) {
+        const int shift = wheel_bits * level;
+        if( ( due >> ( shift + wheel_bits ) ) == ( now >> ( shift + wheel_bits ) ) ) {
+            wheel[level][( due >> shift ) & ( wheel_slots - 1 )].push_back( it );
+            level_size[level]++;
+            return;
+        }
+    }
+    overflow.push_back( it );
+}
+
+void queued_eocs::take_due( const time_point &now, std::vector<storage_iter> &due )
+{
+    if( now < wheel_time ) {
+        // Time went backwards (debug menu, tests), the wheel can't be turned back so start over
+        rebuild( now );
+    }
+    int64_t turn = to_turn<int>( wheel_time );
+    const int64_t target = to_turn<int>( now );
+    std::vector<storage_iter> moving;
+    while( turn < target ) {
+        int lowest = 0;
+        while( lowest < wheel_levels && level_size[lowest] == 0 ) {
+            lowest++;
+        }
+        if( lowest == wheel_levels && overflow.empty() ) {
+            turn = target;
+            break;
+        }
+        // Nothing can come due before the lowest non-empty level turns over, so skip ahead to that
+        const int skip_shift = wheel_bits * lowest;
+        turn = std::min( ( ( turn >> skip_shift ) + 1 ) << skip_shift, target );
+        wheel_time = time_point::from_turn( static_cast<int>( turn ) );
+
+        // Redistribute the buckets whose turn has come, coarsest first so entries can drop
+        // through several levels at once
+        if( ( turn & ( ( int64_t( 1 ) << ( wheel_bits * wheel_levels ) ) - 1 ) ) == 0 ) {
+            moving.swap( overflow );
+            for( storage_iter it : moving ) {
+                place( it );
+            }
+            moving.clear();
+        }
+        for( int level = wheel_levels - 1; level > 0; level-- ) {
+            const int shift = wheel_bits * level;
+            if( ( turn & ( ( int64_t( 1 ) << shift ) - 1 ) ) != 0 ) {
+                continue;
+            }
+            std::vector<storage_iter> &slot = wheel[level][( turn >> shift ) & ( wheel_slots - 1 )];
+            level_size[level] -= static_cast<int>( slot.size() );
+            moving.swap( slot );
+            for( storage_iter it : moving ) {
+                place( it );
+            }
+            moving.clear();
+        }
+        std::vector<storage_iter> &slot = wheel[0][turn & ( wheel_slots - 1 )];
+        level_size[0] -= static_cast<int>( slot.size() );
+        due.insert( due.end(), slot.begin(), slot.end() );
+        slot.clear();
+    }
+    wheel_time = now;
+    due.insert( due.end(), due_now.begin(), due_now.end() );
+    due_now.clear();
+}
+
 void effect_on_conditions::load_new_character( Character &you )
 {
     bool is_avatar = you.is_avatar();
@@ -166,18 +337,14 @@ static void process_new_eocs( queued_eocs &eoc_queue,
                               std::vector<effect_on_condition_id> &eoc_vector,
                               std::map<effect_on_condition_id, bool> &new_eocs, bool global_queue )
 {
-    queued_eocs temp_queued_eocs;
-    while( !eoc_queue.empty() ) {
+    eoc_queue.remove_if( [&new_eocs, global_queue]( const queued_eoc & queued ) {
         // Check if EoC is moved from global to local, or vice versa
-        if( global_queue == eoc_queue.top().eoc->global ) {
-            if( eoc_queue.top().eoc.is_valid() ) {
-                temp_queued_eocs.push( eoc_queue.top() );
-            }
-            new_eocs[eoc_queue.top().eoc] = false;
+        if( global_queue != queued.eoc->global ) {
+            return true;
         }
-        eoc_queue.pop();
-    }
-    eoc_queue = std::move( temp_queued_eocs );
+        new_eocs[queued.eoc] = false;
+        return !queued.eoc.is_valid();
+    } );
     for( auto eoc = eoc_vector.begin();
          eoc != eoc_vector.end(); ) {
         // Check if EoC is moved from global to local, or vice versa
@@ -229,43 +396,70 @@ void effect_on_conditions::queue_effect_on_condition( time_duration duration,
     }
 }
 
+static std::unordered_map<effect_on_condition_id, queued_eoc_stats> queued_stats;
+
 static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_condition_id> &eoc_vector,
                           dialogue &d )
 {
     static std::vector<queued_eocs::storage_iter> eocs_to_queue;
     eocs_to_queue.clear();
 
-    while( !eoc_queue.empty() &&
-           eoc_queue.top().time <= calendar::turn ) {
-        queued_eocs::storage_iter it = eoc_queue.queue.top();
-        queued_eoc &top = *it;
-        eoc_queue.queue.pop();
-
-        dialogue nested_d{ d };
-        for( const auto &val : top.context ) {
-            nested_d.set_value( val.first, val.second );
-        }
-        bool activated = top.eoc->activate( nested_d );
-        if( top.eoc->type == eoc_type::RECURRING ) {
-            if( activated ) { // It worked so add it back
-                it->time = calendar::turn + next_recurrence( top.eoc, d );
-                eocs_to_queue.emplace_back( it );
+    const time_point now = calendar::turn;
+    // taken out of the queue while in use, in case one of the eocs processes the queue again
+    std::vector<queued_eocs::storage_iter> due;
+    due.swap( eoc_queue.due_buffer );
+    eoc_queue.take_due( now, due );
+    // EoCs queued without delay by the ones being run are due as well, so repeat until none are
+    while( !due.empty() ) {
+        std::stable_sort( due.begin(), due.end(), []( const queued_eocs::storage_iter & lhs,
+        const queued_eocs::storage_iter & rhs ) {
+            return lhs->time < rhs->time;
+        } );
+        for( const queued_eocs::storage_iter &it : due ) {
+            queued_eoc &top = *it;
+
+            dialogue nested_d{ d };
+            for( const auto &val : top.context ) {
+                nested_d.set_value( val.first, val.second );
+            }
+            bool activated;
+            if( profiler::counting ) {
+                // timed once, for both the profiler and the queued eoc stats
+                const profiler::clock::time_point start = profiler::clock::now();
+                activated = top.eoc->activate( nested_d );
+                const profiler::clock::time_point end = profiler::clock::now();
+                profiler::record( profiler::category::eoc, top.eoc.str(), start, end );
+                queued_eoc_stats &stats = queued_stats[top.eoc];
+                stats.fired++;
+                stats.activated += activated ? 1 : 0;
+                stats.time += end - start;
             } else {
-                if( !top.eoc->check_deactivate(
-                        nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+                activated = top.eoc->activate( nested_d );
+            }
+            if( top.eoc->type == eoc_type::RECURRING ) {
+                if( activated ) { // It worked so add it back
                     it->time = calendar::turn + next_recurrence( top.eoc, d );
                     eocs_to_queue.emplace_back( it );
-                } else { // It failed and should be deactivated for now
-                    eoc_vector.push_back( top.eoc );
-                    eoc_queue.list.erase( it );
+                } else {
+                    if( !top.eoc->check_deactivate(
+                            nested_d ) ) { // It failed but shouldn't be deactivated so add it back
+                        it->time = calendar::turn + next_recurrence( top.eoc, d );
+                        eocs_to_queue.emplace_back( it );
+                    } else { // It failed and should be deactivated for now
+                        eoc_vector.push_back( top.eoc );
+                        eoc_queue.list.erase( it );
+                    }
                 }
+            } else {
+                eoc_queue.list.erase( it );
             }
-        } else {
-            eoc_queue.list.erase( it );
         }
+        due.clear();
+        eoc_queue.take_due( now, due );
     }
+    eoc_queue.due_buffer.swap( due );
     for( queued_eocs::storage_iter &q_eoc : eocs_to_queue ) {
-        eoc_queue.queue.emplace( q_eoc );
+        eoc_queue.schedule( q_eoc );
     }
 }
 
@@ -284,18 +478,16 @@ static void process_reactivation( std::vector<effect_on_condition_id>
                                   &inactive_effect_on_condition_vector,
                                   queued_eocs &queued_effect_on_conditions, dialogue &d )
 {
-    std::vector<effect_on_condition_id> ids_to_reactivate;
+    std::vector<effect_on_condition_id> still_inactive;
+    still_inactive.reserve( inactive_effect_on_condition_vector.size() );
     for( const effect_on_condition_id &eoc : inactive_effect_on_condition_vector ) {
-        if( !eoc->check_deactivate( d ) ) {
-            ids_to_reactivate.push_back( eoc );
+        if( eoc->check_deactivate( d ) ) {
+            still_inactive.push_back( eoc );
+        } else {
+            queued_effect_on_conditions.push( queued_eoc{ eoc, calendar::turn + next_recurrence( eoc, d ), d.get_context() } );
         }
     }
-    for( const effect_on_condition_id &eoc : ids_to_reactivate ) {
-        queued_effect_on_conditions.push( queued_eoc{ eoc, calendar::turn + next_recurrence( eoc, d ), d.get_context() } );
-        inactive_effect_on_condition_vector.erase( std::remove(
-                    inactive_effect_on_condition_vector.begin(), inactive_effect_on_condition_vector.end(),
-                    eoc ), inactive_effect_on_condition_vector.end() );
-    }
+    inactive_effect_on_condition_vector.swap( still_inactive );
 }
 
 void effect_on_conditions::process_reactivate( Character &you )
@@ -366,13 +558,9 @@ void effect_on_condition::apply_true_effects( dialogue &d )  const
 
 void effect_on_conditions::clear( Character &you )
 {
-    while( !you.queued_effect_on_conditions.empty() ) {
-        you.queued_effect_on_conditions.pop();
-    }
+    you.queued_effect_on_conditions.clear();
     you.inactive_effect_on_condition_vector.clear();
-    while( !g->queued_global_effect_on_conditions.empty() ) {
-        g->queued_global_effect_on_conditions.pop();
-    }
+    g->queued_global_effect_on_conditions.clear();
     g->inactive_global_effect_on_condition_vector.clear();
 }
 
@@ -383,19 +571,9 @@ void effect_on_conditions::write_eocs_to_file( Character &you )
         testfile << "id;timepoint;recurring" << std::endl;
 
         testfile << "queued eocs:" << std::endl;
-        std::vector<queued_eoc> temp_queue;
-        while( !you.queued_effect_on_conditions.empty() ) {
-            temp_queue.push_back( you.queued_effect_on_conditions.top() );
-            you.queued_effect_on_conditions.pop();
-        }
-
-        for( const queued_eoc &queue_entry : temp_queue ) {
-            time_duration temp = queue_entry.time - calendar::turn;
-            testfile << queue_entry.eoc.c_str() << ";" << to_string( temp ) << std::endl;
-        }
-
-        for( const queued_eoc &queued : temp_queue ) {
-            you.queued_effect_on_conditions.push( queued );
+        for( const queued_eoc *queue_entry : you.queued_effect_on_conditions.sorted() ) {
+            time_duration temp = queue_entry->time - calendar::turn;
+            testfile << queue_entry->eoc.c_str() << ";" << to_string( temp ) << std::endl;
         }
 
         testfile << "inactive eocs:" << std::endl;
@@ -413,19 +591,9 @@ void effect_on_conditions::write_global_eocs_to_file( )
         testfile << "id;timepoint;recurring" << std::endl;
 
         testfile << "queued eocs:" << std::endl;
-        std::vector<queued_eoc> temp_queue;
-        while( !g->queued_global_effect_on_conditions.empty() ) {
-            temp_queue.push_back( g->queued_global_effect_on_conditions.top() );
-            g->queued_global_effect_on_conditions.pop();
-        }
-
-        for( const queued_eoc &queue_entry : temp_queue ) {
-            time_duration temp = queue_entry.time - calendar::turn;
-            testfile << queue_entry.eoc.c_str() << ";" << to_string( temp ) << std::endl;
-        }
-
-        for( const queued_eoc &queued : temp_queue ) {
-            g->queued_global_effect_on_conditions.push( queued );
+        for( const queued_eoc *queue_entry : g->queued_global_effect_on_conditions.sorted() ) {
+            time_duration temp = queue_entry->time - calendar::turn;
+            testfile << queue_entry->eoc.c_str() << ";" << to_string( temp ) << std::endl;
         }
 
         testfile << "inactive eocs:" << std::endl;
@@ -436,6 +604,41 @@ void effect_on_conditions::write_global_eocs_to_file( )
     }, "eocs test file" );
 }
 
+const std::unordered_map<effect_on_condition_id, queued_eoc_stats>
+&effect_on_conditions::get_queued_stats()
+{
+    return queued_stats;
+}
+
+std::vector<std::pair<effect_on_condition_id, queued_eoc_stats>>
+        effect_on_conditions::sorted_queued_stats()
+{
+    std::vector<std::pair<effect_on_condition_id, queued_eoc_stats>> sorted( queued_stats.begin(),
+            queued_stats.end() );
+    std::sort( sorted.begin(), sorted.end(), []( const auto & lhs, const auto & rhs ) {
+        return lhs.second.time > rhs.second.time;
+    } );
+    return sorted;
+}
+
+void effect_on_conditions::reset_queued_stats()
+{
+    queued_stats.clear();
+}
+
+void effect_on_conditions::write_queued_stats_to_file()
+{
+    write_to_file( "eoc_stats.output", [&]( std::ostream & testfile ) {
+        testfile << "id;fired;activated;total_ms;average_us" << std::endl;
+        for( const std::pair<effect_on_condition_id, queued_eoc_stats> &entry : sorted_queued_stats() ) {
+            const double total_us = std::chrono::duration<double, std::micro>( entry.second.time ).count();
+            testfile << entry.first.c_str() << ";" << entry.second.fired << ";" << entry.second.activated
+                     << ";" << total_us / 1000.0 << ";" << total_us / std::max( entry.second.fired, 1 )
+                     << std::endl;
+        }
+    }, "eoc stats file" );
+}
+
 void effect_on_conditions::prevent_death()
 {
     avatar &player_character = get_avatar();
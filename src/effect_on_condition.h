@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EFFECT_ON_CONDITION_H
 #define CATA_SRC_EFFECT_ON_CONDITION_H
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
@@ -79,6 +80,13 @@ struct effect_on_condition {
         void check() const;
         effect_on_condition() = default;
 };
+/** How often a queued effect_on_condition has fired and how long it took, for the debug menu */
+struct queued_eoc_stats {
+    int fired = 0;
+    int activated = 0;
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+};
+
 namespace effect_on_conditions
 {
 /** Get all currently loaded effect_on_conditions */
@@ -110,6 +118,16 @@ void clear( Character &you );
 /** write out all queued eocs and inactive eocs to a file for testing */
 void write_eocs_to_file( Character &you );
 void write_global_eocs_to_file();
+/**
+ * Statistics for queued eocs that fired since the last reset, only kept while the profiler is
+ * counting
+ */
+const std::unordered_map<effect_on_condition_id, queued_eoc_stats> &get_queued_stats();
+/** The same statistics, most expensive first */
+std::vector<std::pair<effect_on_condition_id, queued_eoc_stats>> sorted_queued_stats();
+void reset_queued_stats();
+/** write out the queued eoc statistics, most expensive first */
+void write_queued_stats_to_file();
 /** Run all prevent death eocs */
 void prevent_death();
 /** Run all avatar death eocs */
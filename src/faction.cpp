@@ -27,9 +27,12 @@
 #include "game_constants.h"
 #include "input_context.h"
 #include "json_error.h"
+#include "item.h"
+#include "item_location.h"
 #include "line.h"
 #include "localized_comparator.h"
 #include "mission_companion.h"
+#include "monster.h"
 #include "mtype.h"
 #include "npc.h"
 #include "output.h"
@@ -173,6 +176,60 @@ void faction::add_to_membership( const character_id &guy_id, const std::string &
     members[guy_id] = std::make_pair( guy_name, known );
 }
 
+void faction_threat_map::forget_old()
+{
+    if( turn != calendar::turn ) {
+        threats.clear();
+        turn = calendar::turn;
+    }
+}
+
+float faction_threat_map::threat_of( const Creature &critter )
+{
+    float threat = NPC_DANGER_VERY_LOW;
+    if( const monster *const mon = critter.as_monster() ) {
+        threat = std::max( static_cast<float>( mon->type->difficulty ), threat );
+    } else if( const Character *const guy = critter.as_character() ) {
+        const item_location weapon = guy->get_wielded_item();
+        threat = std::max( static_cast<float>( guy->weapon_value( weapon ? *weapon :
+                                               null_item_reference() ) ), threat );
+    }
+    const float hp_percent = static_cast<float>( critter.get_hp() ) / std::max( 1,
+                             critter.get_hp_max() );
+    return std::min( threat * ( hp_percent * 0.5f + 0.5f ), NPC_MONSTER_DANGER_MAX );
+}
+
+void faction_threat_map::add( const Creature &critter, const tripoint_abs_ms &pos )
+{
+    forget_old();
+    auto it = threats.find( &critter );
+    if( it == threats.end() ) {
+        threats.emplace( &critter, std::make_pair( pos, threat_of( critter ) ) );
+    } else {
+        it->second.first = pos;
+    }
+}
+
+float faction_threat_map::danger_at( const tripoint_abs_ms &p ) const
+{
+    if( turn != calendar::turn ) {
+        return 0.0f;
+    }
+    float danger = 0.0f;
+    for( const auto &entry : threats ) {
+        const int dist = rl_dist( p, entry.second.first );
+        if( dist <= danger_range ) {
+            danger += entry.second.second / std::max( 1, dist );
+        }
+    }
+    return danger;
+}
+
+bool faction_threat_map::empty() const
+{
+    return turn != calendar::turn || threats.empty();
+}
+
 void faction::remove_member( const character_id &guy_id )
 {
     for( auto it = members.cbegin(), next_it = it; it != members.cend(); it = next_it ) {
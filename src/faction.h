@@ -12,8 +12,10 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "character_id.h"
 #include "color.h"
+#include "coordinates.h"
 #include "generic_factory.h"
 #include "shop_cons_rate.h"
 #include "stomach.h"
@@ -34,6 +36,7 @@ std::string fac_respect_text( int val );
 std::string fac_wealth_text( int val, int size );
 std::string fac_combat_ability_text( int val );
 
+class Creature;
 class item;
 class JsonObject;
 class JsonOut;
@@ -123,6 +126,35 @@ class faction_template
         std::set<std::tuple<int, int, snippet_id>> epilogue_data;
 };
 
+/**
+ * The hostile creatures that members of a faction in the reality bubble have assessed this
+ * turn, so that every member can keep away from threats that its allies have spotted.
+ * The threat of a creature depends only on the creature, not on which member spotted it or
+ * from how far, so the danger of a tile is the same for the whole faction.
+ * Forgotten when the turn changes.
+ */
+class faction_threat_map
+{
+    public:
+        /** Creatures farther than this from a tile don't make it more dangerous */
+        static constexpr int danger_range = 6;
+
+        /** Threat of @p critter from its own strength and health, whoever is looking at it */
+        static float threat_of( const Creature &critter );
+
+        /** Records a creature at @p pos, or moves it there if it was already recorded this turn */
+        void add( const Creature &critter, const tripoint_abs_ms &pos );
+        /** Danger of standing at @p p, the threats in range weighted by how close they are */
+        float danger_at( const tripoint_abs_ms &p ) const;
+        bool empty() const;
+
+    private:
+        void forget_old();
+
+        time_point turn = calendar::before_time_starts;
+        std::unordered_map<const Creature *, std::pair<tripoint_abs_ms, float>> threats;
+};
+
 class faction : public faction_template
 {
     public:
@@ -149,6 +181,7 @@ class faction : public faction_template
         std::vector<int> opinion_of;
         bool validated = false; // NOLINT(cata-serialize)
         std::map<character_id, std::pair<std::string, bool>> members; // NOLINT(cata-serialize)
+        faction_threat_map threats; // NOLINT(cata-serialize)
 };
 
 class faction_manager
@@ -115,6 +115,7 @@
 #include "item_pocket.h"
 #include "item_search.h"
 #include "item_stack.h"
+#include "item_tname.h"
 #include "iteminfo_query.h"
 #include "itype.h"
 #include "iuse.h"
@@ -8401,6 +8402,7 @@ static std::string list_items_filter_history_help()
 
 game::vmenu_ret game::list_items( const std::vector<map_item_stack> &item_list )
 {
+    tname::cache_scope name_cache;
     std::vector<map_item_stack> ground_items = item_list;
     int iInfoHeight = 0;
     int iMaxRows = 0;
@@ -0,0 +1,184 @@
+#include "global_vars.h"
+
+#include <deque>
+#include <mutex>
+#include <sstream>
+
+#include "cata_utility.h"
+#include "string_formatter.h"
+
+namespace
+{
+struct var_name_table {
+    // guards the table, keys are made from any thread that reads dialogue variables
+    std::mutex mutex;
+    // index 0 is the empty name, used by default constructed keys
+    // a deque, so the names handed out by var_key::str stay put when more are added
+    std::deque<std::string> names{ std::string{} };
+    std::unordered_map<std::string, int> ids{ { std::string{}, 0 } };
+};
+
+var_name_table &get_var_names()
+{
+    static var_name_table table;
+    return table;
+}
+} // namespace
+
+var_key::var_key( std::string_view name )
+{
+    var_name_table &table = get_var_names();
+    // NOLINTNEXTLINE(cata-use-string_view): unordered_map<std::string> can't look up string_views
+    std::string const name_str( name );
+    std::lock_guard<std::mutex> lock( table.mutex );
+    auto it = table.ids.find( name_str );
+    if( it == table.ids.end() ) {
+        it = table.ids.emplace( name_str, static_cast<int>( table.names.size() ) ).first;
+        table.names.emplace_back( name_str );
+    }
+    id_ = it->second;
+}
+
+std::optional<var_key> var_key::find( std::string_view name )
+{
+    var_name_table &table = get_var_names();
+    // NOLINTNEXTLINE(cata-use-string_view): unordered_map<std::string> can't look up string_views
+    std::string const name_str( name );
+    std::lock_guard<std::mutex> lock( table.mutex );
+    auto it = table.ids.find( name_str );
+    if( it == table.ids.end() ) {
+        return std::nullopt;
+    }
+    var_key ret;
+    ret.id_ = it->second;
+    return ret;
+}
+
+const std::string &var_key::str() const
+{
+    var_name_table &table = get_var_names();
+    std::lock_guard<std::mutex> lock( table.mutex );
+    return table.names[id_];
+}
+
+std::optional<double> var_value::dbl() const
+{
+    if( const double *d = std::get_if<double>( &data ) ) {
+        return *d;
+    }
+    if( const std::string *s = std::get_if<std::string>( &data ) ) {
+        return svtod( *s );
+    }
+    return std::nullopt;
+}
+
+std::optional<tripoint_abs_ms> var_value::tripoint() const
+{
+    if( const tripoint_abs_ms *p = std::get_if<tripoint_abs_ms>( &data ) ) {
+        return *p;
+    }
+    if( const std::string *s = std::get_if<std::string>( &data ) ) {
+        std::istringstream is( *s );
+        is.imbue( std::locale::classic() );
+        ::tripoint result;
+        is >> result;
+        if( is ) {
+            return tripoint_abs_ms( result );
+        }
+    }
+    return std::nullopt;
+}
+
+std::string var_value::str() const
+{
+    if( const double *d = std::get_if<double>( &data ) ) {
+        // NOLINTNEXTLINE(cata-translate-string-literal)
+        return string_format( "%g", *d );
+    }
+    if( const tripoint_abs_ms *p = std::get_if<tripoint_abs_ms>( &data ) ) {
+        return p->to_string();
+    }
+    return std::get<std::string>( data );
+}
+
+static std::string exact_str( double d )
+{
+    // use the shortest representation that reads back as the same value
+    for( int precision = 6; precision < 17; precision++ ) {
+        // NOLINTNEXTLINE(cata-translate-string-literal)
+        std::string ret = string_format( "%.*g", precision, d );
+        if( svtod( ret ) == d ) {
+            return ret;
+        }
+    }
+    // NOLINTNEXTLINE(cata-translate-string-literal)
+    return string_format( "%.17g", d );
+}
+
+std::string var_value::serialize_str() const
+{
+    if( const double *d = std::get_if<double>( &data ) ) {
+        return exact_str( *d );
+    }
+    return str();
+}
+
+var_value var_value::from_saved( std::string v )
+{
+    // only numbers that serialize_str writes back the same way, so strings like "05" or
+    // "1.50" that dialogue compares as text are kept as they were
+    if( std::optional<double> d = svtod( v ) ) {
+        if( exact_str( *d ) == v ) {
+            return var_value( *d );
+        }
+    }
+    return var_value( std::move( v ) );
+}
+
+std::unordered_map<std::string, std::string> var_store::to_strings() const
+{
+    std::unordered_map<std::string, std::string> ret;
+    for( const std::pair<const var_key, var_value> &v : values ) {
+        ret.emplace( v.first.str(), v.second.str() );
+    }
+    return ret;
+}
+
+void var_store::from_strings( const std::unordered_map<std::string, std::string> &input )
+{
+    values.clear();
+    for( const std::pair<const std::string, std::string> &v : input ) {
+        values.emplace( var_key( v.first ), var_value::from_saved( v.second ) );
+    }
+}
+
+void var_store::migrate( const std::map<std::string, std::string> &migrations )
+{
+    for( const std::pair<const std::string, std::string> &migration : migrations ) {
+        const std::optional<var_key> old_key = var_key::find( migration.first );
+        auto it = old_key ? values.find( *old_key ) : values.end();
+        if( it != values.end() ) {
+            auto extracted = values.extract( it );
+            extracted.key() = var_key( migration.second );
+            values.insert( std::move( extracted ) );
+        }
+    }
+}
+
+void var_store::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const std::pair<const var_key, var_value> &v : values ) {
+        jsout.member( v.first.str(), v.second.serialize_str() );
+    }
+    jsout.end_object();
+}
+
+void var_store::deserialize( const JsonValue &jv )
+{
+    JsonObject jo = jv.get_object();
+    values.clear();
+    for( const JsonMember jm : jo ) {
+        values.emplace( var_key( jm.name() ), var_value::from_saved( jm.get_string() ) );
+    }
+}
@@ -1,8 +1,17 @@
 #pragma once
 #ifndef CATA_SRC_GLOBAL_VARS_H
 #define CATA_SRC_GLOBAL_VARS_H
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 
+#include "coordinates.h"
 #include "json.h"
 
 enum class var_type : int {
@@ -16,21 +25,148 @@ enum class var_type : int {
     last
 };
 
+/**
+ * Interned variable name.  Names are interned once, when the JSON or expression referencing
+ * them is loaded, so that variable lookups hash and compare an int instead of a string.
+ * The default key is the empty name.
+ */
+class var_key
+{
+    public:
+        var_key() = default;
+        explicit var_key( std::string_view name );
+        /** The key of `name` if it was interned, without interning it */
+        static std::optional<var_key> find( std::string_view name );
+
+        const std::string &str() const;
+        int id() const {
+            return id_;
+        }
+
+        bool operator==( const var_key &rhs ) const {
+            return id_ == rhs.id_;
+        }
+        bool operator!=( const var_key &rhs ) const {
+            return id_ != rhs.id_;
+        }
+
+    private:
+        int id_ = 0;
+};
+
+namespace std
+{
+template <>
+struct hash<var_key> {
+    std::size_t operator()( const var_key &k ) const noexcept {
+        return static_cast<size_t>( k.id() );
+    }
+};
+} // namespace std
+
+/**
+ * Value of a dialogue variable, kept in the type it was written as.  Conversion to and from
+ * strings only happens when a value is read as a different type and when it is saved.
+ */
+class var_value
+{
+    public:
+        var_value() = default;
+        explicit var_value( std::string v ) : data( std::move( v ) ) {}
+        explicit var_value( double v ) : data( v ) {}
+        explicit var_value( const tripoint_abs_ms &v ) : data( v ) {}
+
+        bool is_dbl() const {
+            return std::holds_alternative<double>( data );
+        }
+        /** Returns nullopt if this is a string that doesn't hold a number */
+        std::optional<double> dbl() const;
+        /** Returns nullopt if this is a string that doesn't hold a tripoint */
+        std::optional<tripoint_abs_ms> tripoint() const;
+        /** String form as seen by dialogue, same format older versions stored */
+        std::string str() const;
+        /** String form written to save files, doesn't lose precision */
+        std::string serialize_str() const;
+        /** Reads a value written by serialize_str, numbers are stored as numbers again */
+        static var_value from_saved( std::string v );
+
+    private:
+        std::variant<std::string, double, tripoint_abs_ms> data;
+};
+
+/** Map of interned variable names to typed values */
+class var_store
+{
+    public:
+        using container_t = std::unordered_map<var_key, var_value>;
+
+        void set( const var_key &key, var_value val ) {
+            values[key] = std::move( val );
+        }
+        void erase( const var_key &key ) {
+            values.erase( key );
+        }
+        const var_value *find( const var_key &key ) const {
+            auto it = values.find( key );
+            return it == values.end() ? nullptr : &it->second;
+        }
+        /** Lookups by name don't intern names that were never set */
+        void erase( std::string_view name ) {
+            if( std::optional<var_key> key = var_key::find( name ) ) {
+                erase( *key );
+            }
+        }
+        const var_value *find( std::string_view name ) const {
+            std::optional<var_key> key = var_key::find( name );
+            return key ? find( *key ) : nullptr;
+        }
+        void clear() {
+            values.clear();
+        }
+        bool empty() const {
+            return values.empty();
+        }
+        container_t::const_iterator begin() const {
+            return values.begin();
+        }
+        container_t::const_iterator end() const {
+            return values.end();
+        }
+
+        std::unordered_map<std::string, std::string> to_strings() const;
+        void from_strings( const std::unordered_map<std::string, std::string> &input );
+        /** Rename variables according to `migrations` (old name -> new name) */
+        void migrate( const std::map<std::string, std::string> &migrations );
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( const JsonValue &jv );
+
+    private:
+        container_t values;
+};
+
 class global_variables
 {
     public:
         // Methods for setting/getting misc key/value pairs.
         void set_global_value( const std::string &key, const std::string &value ) {
-            global_values[ key ] = value;
+            global_values.set( var_key( key ), var_value( value ) );
+        }
+        void set_global_value( const var_key &key, var_value value ) {
+            global_values.set( key, std::move( value ) );
         }
 
         void remove_global_value( const std::string &key ) {
             global_values.erase( key );
         }
 
+        const var_value *get_global( const var_key &key ) const {
+            return global_values.find( key );
+        }
+
         std::optional<std::string> maybe_get_global_value( const std::string &key ) const {
-            auto it = global_values.find( key );
-            return it == global_values.end() ? std::nullopt : std::optional<std::string> { it->second };
+            const var_value *val = global_values.find( key );
+            return val == nullptr ? std::nullopt : std::optional<std::string> { val->str() };
         }
 
         std::string get_global_value( const std::string &key ) const {
@@ -38,15 +174,15 @@ class global_variables
         }
 
         std::unordered_map<std::string, std::string> get_global_values() const {
-            return global_values;
+            return global_values.to_strings();
         }
 
         void clear_global_values() {
             global_values.clear();
         }
 
-        void set_global_values( std::unordered_map<std::string, std::string> input ) {
-            global_values = std::move( input );
+        void set_global_values( const std::unordered_map<std::string, std::string> &input ) {
+            global_values.from_strings( input );
         }
         void unserialize( JsonObject &jo );
         void serialize( JsonOut &jsout ) const;
@@ -55,7 +191,7 @@ class global_variables
         static void load_migrations( const JsonObject &jo, const std::string_view &src );
 
     private:
-        std::unordered_map<std::string, std::string> global_values;
+        var_store global_values;
 };
 global_variables &get_globals();
 
@@ -74,6 +74,7 @@
 #include "options.h"
 #include "output.h"
 #include "overmap_ui.h"
+#include "overmapbuffer.h"
 #include "panels.h"
 #include "player_activity.h"
 #include "popup.h"
@@ -275,6 +276,9 @@ input_context game::get_player_input( std::string &action )
 #endif
 
     user_turn current_turn;
+    // At most one overmap is made ahead of time per wait for input, so idling
+    // costs no more than one overmap's generation before the next keypress is handled.
+    bool generated_ahead = false;
 
     if( get_option<bool>( "ANIMATIONS" ) ) {
         const int TOTAL_VIEW = MAX_VIEW_DISTANCE * 2 + 1;
@@ -425,6 +429,9 @@ input_context game::get_player_input( std::string &action )
             }
 
             ui_manager::redraw_invalidated();
+            if( action == "TIMEOUT" && !generated_ahead ) {
+                generated_ahead = overmap_buffer.generate_ahead( u.global_omt_location() );
+            }
         } while( handle_mouseview( ctxt, action ) && uquit != QUIT_WATCH
                  && ( action != "TIMEOUT" || !current_turn.has_timeout_elapsed() ) );
         ctxt.reset_timeout();
@@ -434,6 +441,9 @@ input_context game::get_player_input( std::string &action )
             if( action == "TIMEOUT" && current_turn.has_timeout_elapsed() ) {
                 break;
             }
+            if( action == "TIMEOUT" && !generated_ahead ) {
+                generated_ahead = overmap_buffer.generate_ahead( u.global_omt_location() );
+            }
         }
         ctxt.reset_timeout();
     }
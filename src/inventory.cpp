@@ -35,6 +35,7 @@
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
+#include "visitable-inl.h"
 #include "vpart_position.h"
 
 static const itype_id itype_acetaminophen( "acetaminophen" );
@@ -301,6 +302,7 @@ char inventory::find_usable_cached_invlet( const itype_id &item_type )
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
     binned = false;
+    item::note_type_or_contents_change();
 
     Character &player_character = get_player_character();
     if( should_stack ) {
@@ -1127,7 +1129,7 @@ const itype_bin &inventory::get_binned_items() const
 
     // HACK: Hack warning
     inventory *this_nonconst = const_cast<inventory *>( this );
-    this_nonconst->visit_items( [ this ]( item * e, item * ) {
+    this_nonconst->visit_items_inline( [ this ]( item * e, item * ) {
         binned_items[ e->typeId() ].push_back( e );
         for( const item *it : e->softwares() ) {
             binned_items[it->typeId()].push_back( it );
@@ -254,6 +254,9 @@ class inventory : public visitable
         bool has_quality( const quality_id &qual, int level = 1, int qty = 1 ) const override;
         VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const
         override;
+        /** Like @ref visit_items with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_items_inline( Visitor &&func ) const;
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
                                            int count = INT_MAX ) override;
         int charges_of( const itype_id &what, int limit = INT_MAX,
@@ -21,6 +21,7 @@
 #include "input_context.h"
 #include "item_category.h"
 #include "item_location.h"
+#include "item_tname.h"
 #include "pocket_type.h"
 #include "pimpl.h"
 #include "translations.h"
@@ -784,6 +785,9 @@ class inventory_selector
         bool force_single_column = false;
 
     private:
+        // The columns ask for the names of every visible entry on each redraw
+        tname::cache_scope name_cache;
+
         // These functions are called from resizing/redraw callbacks of ui_adaptor
         // and should not be made protected or public.
         void prepare_layout( size_t client_width, size_t client_height );
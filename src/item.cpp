@@ -288,6 +288,18 @@ struct scoped_goes_bad_cache {
 
 const int item::INFINITE_CHARGES = INT_MAX;
 
+static uint64_t type_or_contents_change_count = 0;
+
+uint64_t item::type_or_contents_changes()
+{
+    return type_or_contents_change_count;
+}
+
+void item::note_type_or_contents_change()
+{
+    ++type_or_contents_change_count;
+}
+
 item::item() : bday( calendar::start_of_cataclysm )
 {
     type = nullitem();
@@ -636,6 +648,7 @@ item &item::convert( const itype_id &new_type, Character *carrier )
     // Carry over relative rot similar to crafting
     const double rel_rot = get_relative_rot();
     type = find_type( new_type );
+    note_type_or_contents_change();
     set_relative_rot( rel_rot );
     requires_tags_processing = true; // new type may have "active" flags
     item temp( *this );
@@ -1812,6 +1825,7 @@ void item::set_var( const std::string &name, const int value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    forget_name();
 }
 
 void item::set_var( const std::string &name, const long long value )
@@ -1820,6 +1834,7 @@ void item::set_var( const std::string &name, const long long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    forget_name();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
@@ -1829,11 +1844,13 @@ void item::set_var( const std::string &name, const long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    forget_name();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
     item_vars[name] = string_format( "%f", value );
+    forget_name();
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
@@ -1876,6 +1893,7 @@ double item::get_var( const std::string &name, const double default_value ) cons
 void item::set_var( const std::string &name, const tripoint &value )
 {
     item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    forget_name();
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
@@ -1903,6 +1921,7 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 void item::set_var( const std::string &name, const std::string &value )
 {
     item_vars[name] = value;
+    forget_name();
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
@@ -1933,11 +1952,13 @@ bool item::has_var( const std::string &name ) const
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    forget_name();
 }
 
 void item::clear_vars()
 {
     item_vars.clear();
+    forget_name();
 }
 
 // TODO: Get rid of, handle multiple types gracefully
@@ -6727,6 +6748,7 @@ void item::on_contents_changed()
     encumbrance_update_ = true;
     update_inherited_flags();
     cached_category.timestamp = calendar::turn_max;
+    forget_name();
     if( empty_container() ) {
         clear_automatic_whitelist();
     }
@@ -6812,8 +6834,30 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
     return tname( quantity, with_prefix ? tname::default_tname : tname::unprefixed_tname );
 }
 
+bool item::tname_cache_matches( const tname::cached_name &c, unsigned int quantity,
+                                const tname::segment_bitset &segments ) const
+{
+    return c.timestamp == calendar::turn &&
+           c.quantity == quantity && c.segments == segments &&
+           c.language_version == detail::get_current_language_version() && c.type == type &&
+           c.charges == charges && c.damage == damage_ && c.degradation == degradation_ &&
+           c.item_counter == item_counter && c.wetness == wetness && c.burnt == burnt &&
+           c.faults == faults.size() &&
+           c.active == active && c.favorite == is_favorite;
+}
+
 std::string item::tname( unsigned int quantity, tname::segment_bitset const &segments ) const
 {
+    tname::cache_scope *const name_cache = tname::cache_scope::innermost();
+    const tname::cached_name_key *const key = this;
+    if( name_cache != nullptr ) {
+        const auto cached = name_cache->names.find( key );
+        if( cached != name_cache->names.end() &&
+            tname_cache_matches( cached->second, quantity, segments ) ) {
+            return cached->second.name;
+        }
+    }
+
     std::string ret;
 
     for( size_t i = 0; i < static_cast<size_t>( tname::segments::last_segment ); i++ ) {
@@ -6826,9 +6870,15 @@ std::string item::tname( unsigned int quantity, tname::segment_bitset const &seg
 
     if( item_vars.find( "item_note" ) != item_vars.end() ) {
         //~ %s is an item name. This style is used to denote items with notes.
-        return string_format( _( "*%s*" ), ret );
+        ret = string_format( _( "*%s*" ), ret );
     }
 
+    if( name_cache != nullptr ) {
+        name_cache->names[key] = { ret, quantity, segments, detail::get_current_language_version(),
+                                   type, charges, damage_, degradation_, item_counter, wetness, burnt,
+                                   faults.size(), active, is_favorite, calendar::turn
+                                 };
+    }
     return ret;
 }
 
@@ -7554,6 +7604,7 @@ void item::unset_flags()
 {
     item_tags.clear();
     requires_tags_processing = true;
+    forget_name();
 }
 
 bool item::has_fault( const fault_id &fault ) const
@@ -7606,6 +7657,7 @@ item &item::set_flag( const flag_id &flag )
         item_tags.insert( flag );
         update_prefix_suffix_flags( flag );
         requires_tags_processing = true;
+        forget_name();
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -7644,6 +7696,7 @@ item &item::unset_flag( const flag_id &flag )
     item_tags.erase( flag );
     update_prefix_suffix_flags();
     requires_tags_processing = true;
+    forget_name();
     return *this;
 }
 
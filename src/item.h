@@ -192,7 +192,7 @@ struct stacking_info {
     }
 };
 
-class item : public visitable
+class item : public visitable, public tname::cached_name_key
 {
     public:
         using FlagsSetType = std::set<flag_id>;
@@ -2903,6 +2903,12 @@ class item : public visitable
          */
         VisitResponse visit_contents( const std::function<VisitResponse( item *, item * )> &func,
                                       item *parent = nullptr );
+        /** Like @ref visit_contents with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_contents_inline( Visitor &func, item *parent );
+        /** Like @ref visit_items with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_items_inline( Visitor &&func ) const;
         void remove_internal( const std::function<bool( item & )> &filter,
                               int &count, std::list<item> &res );
         std::list<item> remove_items_with( const std::function<bool( const item & )> &filter,
@@ -3069,6 +3075,14 @@ class item : public visitable
     public:
         static const int INFINITE_CHARGES;
 
+        /**
+         * Counts the items that changed type and the items put into pockets, wielded or added
+         * to an inventory, anywhere.  Caches of which items a character carries compare it to
+         * tell whether they may be missing one.
+         */
+        static uint64_t type_or_contents_changes();
+        static void note_type_or_contents_change();
+
         const itype *type;
         item_components components;
         /** What faults (if any) currently apply to this item */
@@ -3202,6 +3216,9 @@ class item : public visitable
         };
         mutable cat_cache cached_category;
 
+        bool tname_cache_matches( const tname::cached_name &c, unsigned int quantity,
+                                  const tname::segment_bitset &segments ) const;
+
         // additional encumbrance this specific item has
         units::volume additional_encumbrance = 0_ml;
 
@@ -354,6 +354,9 @@ class item_contents
          */
         VisitResponse visit_contents( const std::function<VisitResponse( item *, item * )> &func,
                                       item *parent = nullptr );
+        /** Like @ref visit_contents with the visitor inlined, defined in visitable-inl.h */
+        template<typename Visitor>
+        VisitResponse visit_contents_inline( Visitor &func, item *parent );
         void remove_internal( const std::function<bool( item & )> &filter,
                               int &count, std::list<item> &res );
 
@@ -2116,6 +2116,7 @@ const pocket_data *item_pocket::get_pocket_data() const
 
 void item_pocket::add( const item &it, item **ret )
 {
+    item::note_type_or_contents_change();
     contents.push_back( it );
     if( ret == nullptr ) {
         restack();
@@ -2126,6 +2127,7 @@ void item_pocket::add( const item &it, item **ret )
 
 void item_pocket::add( const item &it, const int copies, std::vector<item *> &added )
 {
+    item::note_type_or_contents_change();
     for( auto iter = contents.insert( contents.end(), copies, it ); iter != contents.end(); iter++ ) {
         added.push_back( &*iter );
     }
@@ -2191,6 +2193,7 @@ int item_pocket::fill_with( const item &contained, Character &guy, int amount,
 
 std::list<item> &item_pocket::edit_contents()
 {
+    item::note_type_or_contents_change();
     return contents;
 }
 
@@ -2203,6 +2206,7 @@ ret_val<item *> item_pocket::insert_item( const item &it,
         return ret_val<item *>::make_failure( nullptr, containable.str() );
     }
 
+    item::note_type_or_contents_change();
     item *inserted = nullptr;
     if( !into_bottom ) {
         contents.push_front( it );
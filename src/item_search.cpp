@@ -1,9 +1,11 @@
 #include "item_search.h"
 
 #include <map>
+#include <unordered_set>
 #include <utility>
 
 #include "avatar.h"
+#include "bodypart.h"
 #include "cata_utility.h"
 #include "item.h"
 #include "item_category.h"
@@ -14,6 +16,10 @@
 
 static std::pair<std::string, std::string> get_both( std::string_view a );
 
+// The filters are compiled once and then run on every item of the list being filtered, so
+// anything that doesn't depend on the item is looked up up front: names of categories,
+// materials and qualities are matched once against all of them, leaving a check of the item's
+// ids, and the query is lowercased once instead of for every item.
 std::function<bool( const item & )> basic_item_filter( std::string filter )
 {
     size_t colon;
@@ -24,38 +30,72 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             filter = filter.substr( colon + 1 );
         }
     }
+    const lcmatch_query query( filter );
     switch( flag ) {
         // category
-        case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category_of_contents().name_header(), filter );
+        case 'c': {
+            std::unordered_set<item_category_id> filtered_categories;
+            for( const item_category &cat : item_category::get_all() ) {
+                if( query.matches( cat.name_header() ) ) {
+                    filtered_categories.insert( cat.get_id() );
+                }
+            }
+            return [filtered_categories]( const item & i ) {
+                return !filtered_categories.empty() &&
+                       filtered_categories.count( i.get_category_of_contents().get_id() ) > 0;
             };
+        }
         // material
-        case 'm':
-            return [filter]( const item & i ) {
-                return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const std::pair<material_id, int> &mat ) {
-                    return lcmatch( mat.first->name(), filter );
+        case 'm': {
+            std::unordered_set<material_id> filtered_materials;
+            for( const material_type &mat : materials::get_all() ) {
+                if( query.matches( mat.name() ) ) {
+                    filtered_materials.insert( mat.id );
+                }
+            }
+            return [filtered_materials]( const item & i ) {
+                if( filtered_materials.empty() ) {
+                    return false;
+                }
+                const std::map<material_id, int> &mats = i.made_of();
+                return std::any_of( mats.begin(), mats.end(),
+                [&filtered_materials]( const std::pair<const material_id, int> &mat ) {
+                    return filtered_materials.count( mat.first ) > 0;
                 } );
             };
+        }
         // qualities
-        case 'q':
-            return [filter]( const item & i ) {
-                return i.type->has_any_quality( filter );
+        case 'q': {
+            std::unordered_set<quality_id> filtered_qualities;
+            for( const quality &qual : quality::get_all() ) {
+                if( query.matches( qual.name ) ) {
+                    filtered_qualities.insert( qual.id );
+                }
+            }
+            return [filtered_qualities]( const item & i ) {
+                const auto has_quality = [&filtered_qualities]( const std::pair<const quality_id, int> &q ) {
+                    return filtered_qualities.count( q.first ) > 0;
+                };
+                return !filtered_qualities.empty() &&
+                       ( std::any_of( i.type->qualities.begin(), i.type->qualities.end(), has_quality ) ||
+                         std::any_of( i.type->charged_qualities.begin(), i.type->charged_qualities.end(),
+                                      has_quality ) );
             };
+        }
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const std::pair<std::string, std::string> pair = get_both( filter );
+            return [first = item_filter_from_string( pair.first ),
+                            second = item_filter_from_string( pair.second )]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( const item_comp &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( query.matches( component.to_string() ) ) {
                         return true;
                     }
                 }
@@ -63,27 +103,29 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && query.matches( note );
             };
         // item flags, must type in whole flag string name(case insensitive) so as to avoid revealing hidden flags.
-        case 'f':
-            return [filter]( const item & i ) {
-                std::string flag_filter = filter;
-                transform( flag_filter.begin(), flag_filter.end(), flag_filter.begin(), ::toupper );
-                const flag_id fsearch( flag_filter );
-                if( fsearch.is_valid() ) {
-                    return i.has_flag( fsearch );
-                } else {
+        case 'f': {
+            std::string flag_filter = filter;
+            transform( flag_filter.begin(), flag_filter.end(), flag_filter.begin(), ::toupper );
+            const flag_id fsearch( flag_filter );
+            if( !fsearch.is_valid() ) {
+                return []( const item & ) {
                     return false;
-                }
+                };
+            }
+            return [fsearch]( const item & i ) {
+                return i.has_flag( fsearch );
             };
+        }
         // by book skill
         case 's':
-            return [filter]( const item & i ) {
+            return [query]( const item & i ) {
                 if( get_avatar().has_identified( i.typeId() ) ) {
-                    return lcmatch( i.get_book_skill(), filter );
+                    return query.matches( i.get_book_skill() );
                 }
                 return false;
             };
@@ -93,18 +135,17 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             std::unordered_set<sub_bodypart_id> filtered_sub_bodyparts;
             for( const body_part &bp : all_body_parts ) {
                 const bodypart_str_id &bp_str_id = convert_bp( bp );
-                if( lcmatch( body_part_name( bp_str_id, 1 ), filter )
-                    || lcmatch( body_part_name( bp_str_id, 2 ), filter ) ) {
+                if( query.matches( body_part_name( bp_str_id, 1 ) )
+                    || query.matches( body_part_name( bp_str_id, 2 ) ) ) {
                     filtered_bodyparts.insert( bp_str_id->id );
                 }
                 for( const sub_bodypart_str_id &sbp : bp_str_id->sub_parts ) {
-                    if( lcmatch( sbp->name.translated(), filter )
-                        || lcmatch( sbp->name_multiple.translated(), filter ) ) {
+                    if( query.matches( sbp->name ) || query.matches( sbp->name_multiple ) ) {
                         filtered_sub_bodyparts.insert( sbp->id );
                     }
                 }
             }
-            return [filter, filtered_bodyparts, filtered_sub_bodyparts]( const item & i ) {
+            return [filtered_bodyparts, filtered_sub_bodyparts]( const item & i ) {
                 return std::any_of( filtered_bodyparts.begin(), filtered_bodyparts.end(),
                 [&i]( const bodypart_id & bp ) {
                     return i.covers( bp );
@@ -117,8 +158,8 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
         }
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( remove_color_tags( a.tname() ), filter );
+            return [query]( const item & a ) {
+                return query.matches( remove_color_tags( a.tname() ) );
             };
     }
 }
@@ -36,16 +36,12 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
         std::vector<std::function<bool( const T & )> > functions;
         // Functions that must all return true
         std::vector<std::function<bool( const T & )> > inv_functions;
+        std::vector<std::string> filters;
         size_t comma = filter.find( ',' );
         while( !filter.empty() ) {
             const std::string &current_filter = trim( filter.substr( 0, comma ) );
             if( !current_filter.empty() ) {
-                auto current_func = filter_from_string( current_filter, basic_filter );
-                if( current_filter[0] == '-' ) {
-                    inv_functions.push_back( current_func );
-                } else {
-                    functions.push_back( current_func );
-                }
+                filters.push_back( current_filter );
             }
             if( comma != std::string::npos ) {
                 filter = trim( filter.substr( comma + 1 ) );
@@ -54,6 +50,18 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
                 break;
             }
         }
+        // Prefixed queries mostly compare ids, try them before the plain ones that match names
+        std::stable_partition( filters.begin(), filters.end(), []( const std::string & f ) {
+            return f.find( ':' ) != std::string::npos;
+        } );
+        for( const std::string &current_filter : filters ) {
+            auto current_func = filter_from_string( current_filter, basic_filter );
+            if( current_filter[0] == '-' ) {
+                inv_functions.push_back( current_func );
+            } else {
+                functions.push_back( current_func );
+            }
+        }
 
         return [functions, inv_functions]( const T & it ) {
             auto apply = [&]( const std::function<bool( const T & )> &func ) {
@@ -76,8 +84,8 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
     }
     const bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter, basic_filter]( const T & i ) {
-            return !filter_from_string( filter.substr( 1 ), basic_filter )( i );
+        return [func = filter_from_string( filter.substr( 1 ), basic_filter )]( const T & i ) {
+            return !func( i );
         };
     }
 
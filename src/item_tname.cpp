@@ -618,4 +618,49 @@ std::string print_segment( tname::segments segment, item const &it, unsigned int
     size_t const idx = static_cast<size_t>( segment );
     return ( *arr.at( idx ) )( it, quantity, segments );
 }
+
+static cache_scope *innermost_scope = nullptr;
+
+cache_scope::cache_scope() : outer( innermost_scope )
+{
+    innermost_scope = this;
+}
+
+cache_scope::~cache_scope()
+{
+    innermost_scope = outer;
+    if( outer != nullptr ) {
+        // anything may have changed inside of this scope
+        outer->names.clear();
+    }
+}
+
+cache_scope *cache_scope::innermost()
+{
+    return innermost_scope;
+}
+
+cached_name_key &cached_name_key::operator=( const cached_name_key & )
+{
+    forget_name();
+    return *this;
+}
+
+cached_name_key &cached_name_key::operator=( cached_name_key && ) noexcept
+{
+    forget_name();
+    return *this;
+}
+
+cached_name_key::~cached_name_key()
+{
+    forget_name();
+}
+
+void cached_name_key::forget_name() const
+{
+    if( innermost_scope != nullptr ) {
+        innermost_scope->names.erase( this );
+    }
+}
 } // namespace tname
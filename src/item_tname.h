@@ -4,11 +4,14 @@
 
 #include <cstddef>
 #include <string>
+#include <unordered_map>
 
+#include "calendar.h"
 #include "enum_bitset.h"
 #include "enum_traits.h"
 
 class item;
+struct itype;
 
 namespace tname
 {
@@ -119,6 +122,73 @@ constexpr segment_bitset tname_contents( tname_contents_bits );
 constexpr segment_bitset tname_conditional( tname_conditional_bits );
 constexpr segment_bitset item_name( item_name_bits );
 
+#ifndef CATA_IN_TOOL
+
+/**
+ * Base of item that stands for it in the cache_scope.  An item that is destroyed, or has
+ * another item assigned over it, drops the name kept for it.  Empty, so it adds nothing to
+ * the size of an item.
+ */
+class cached_name_key
+{
+    protected:
+        cached_name_key() = default;
+        cached_name_key( const cached_name_key & ) = default;
+        cached_name_key( cached_name_key && ) noexcept = default;
+        cached_name_key &operator=( const cached_name_key & );
+        cached_name_key &operator=( cached_name_key && ) noexcept;
+        ~cached_name_key();
+
+        // Drops the name kept for this item in the innermost cache_scope, if any
+        void forget_name() const;
+};
+
+// A name printed by item::tname, and the state of the item it was printed from
+struct cached_name {
+    std::string name;
+    unsigned int quantity = 0;
+    segment_bitset segments;
+    int language_version = 0;
+    const itype *type = nullptr;
+    int charges = 0;
+    int damage = 0;
+    int degradation = 0;
+    int item_counter = 0;
+    int wetness = 0;
+    int burnt = 0;
+    size_t faults = 0;
+    bool active = false;
+    bool favorite = false;
+    time_point timestamp = calendar::turn_max;
+};
+
+/**
+ * While one of these is alive, item::tname keeps the last name it printed for each item and
+ * returns it again as long as the item hasn't changed.  For the menus that redraw long lists
+ * of items on every keypress.  The name also depends on the avatar and the rest of the game,
+ * which these menus don't change while they are open.  The names are kept by the innermost
+ * scope, and the scope around it forgets its own when that one ends, so names printed before
+ * a scope are never reused inside of it or after it.
+ */
+class cache_scope
+{
+    public:
+        cache_scope();
+        ~cache_scope();
+        cache_scope( const cache_scope & ) = delete;
+        cache_scope &operator=( const cache_scope & ) = delete;
+
+        // The innermost live scope, or nullptr if there is none
+        static cache_scope *innermost();
+
+        std::unordered_map<const cached_name_key *, cached_name> names;
+
+    private:
+        cache_scope *outer;
+};
+
+#endif // CATA_IN_TOOL
+
 } // namespace tname
 
 #endif // CATA_SRC_ITEM_TNAME_H
@@ -78,6 +78,7 @@
 #include "overmapbuffer.h"
 #include "pathfinding.h"
 #include "pocket_type.h"
+#include "profiler.h"
 #include "projectile.h"
 #include "ranged.h"
 #include "relic.h"
@@ -5703,6 +5704,9 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
 
         map_stack items = i_at( map_location );
 
+        profiler::scope prof( profiler::category::active_item, [&active_item_ref]() {
+            return active_item_ref.item_ref->typeId();
+        } );
         process_map_items( *this, items, active_item_ref.item_ref, active_item_ref.parent,
                            map_location, 1, flag,
                            spoil_multiplier * active_item_ref.spoil_multiplier() );
@@ -5784,6 +5788,9 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
                 flag = temperature_flag::HEATER;
             }
         }
+        profiler::scope prof( profiler::category::active_item, [&target]() {
+            return target.typeId();
+        } );
         if( !process_map_items( *this, items, active_item_ref.item_ref, active_item_ref.parent,
                                 item_loc, it_insulation, flag,
                                 active_item_ref.spoil_multiplier() ) ) {
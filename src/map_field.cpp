@@ -54,6 +54,7 @@
 #include "npc.h"
 #include "overmapbuffer.h"
 #include "point.h"
+#include "profiler.h"
 #include "rng.h"
 #include "scent_block.h"
 #include "scent_map.h"
@@ -481,8 +482,11 @@ void map::process_fields_in_submap( submap *const current_submap,
                     continue;
                 }
 
-                for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
-                    proc( p, cur, pd );
+                {
+                    profiler::scope prof( profiler::category::field, pd.cur_fd_type_id );
+                    for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
+                        proc( p, cur, pd );
+                    }
                 }
 
                 cur.do_decay();
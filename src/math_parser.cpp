@@ -1,6 +1,7 @@
 #include "math_parser.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <locale>
 #include <map>
@@ -211,10 +212,268 @@ void _validate_unused_kwargs( diag_kwargs const &kwargs )
     }
 }
 
+double _read_var_dbl( var_info const &varinfo, dialogue &d )
+{
+    std::optional<var_value> const val = maybe_read_var( varinfo, d );
+    if( std::optional<double> ret = val ? val->dbl() : std::nullopt; ret ) {
+        return *ret;
+    }
+    std::string const str = val ? val->str() : varinfo.default_val;
+    if( str.empty() ) {
+        return 0;
+    }
+    if( std::optional<double> ret = svtod( str ); ret ) {
+        return *ret;
+    }
+    debugmsg( R"(failed to convert variable "%s" with value "%s" to a number)", varinfo.name, str );
+    return 0;
+}
+
+class bytecode_compiler
+{
+    public:
+        explicit bytecode_compiler( math_bytecode &bc_ ) : bc( bc_ ) {}
+
+        bool emit( thingie const &t ) {
+            return std::visit( overloaded{
+                [this]( double v )
+                {
+                    push( v );
+                    return true;
+                },
+                [this]( oper const & v )
+                {
+                    return emit_oper( v );
+                },
+                [this]( func const & v )
+                {
+                    return emit_func( v );
+                },
+                [this]( func_jmath const & v )
+                {
+                    return emit_jmath( v );
+                },
+                [this]( func_diag_eval const & v )
+                {
+                    add( { math_bytecode::opcode::call_diag, static_cast<int>( bc.diags.size() ) }, 1 );
+                    bc.diags.emplace_back( v );
+                    return true;
+                },
+                [this]( var const & v )
+                {
+                    add( { math_bytecode::opcode::load_var, slot_for( v.varinfo ) }, 1 );
+                    return true;
+                },
+                [this]( ternary const & v )
+                {
+                    return emit_ternary( v );
+                },
+                // strings, kwargs and arrays only exist as dialogue function arguments, and
+                // assignment functions can't be evaluated
+                []( auto const &/* v */ )
+                {
+                    return false;
+                },
+            },
+            t.data );
+        }
+
+        bool overflowed() const {
+            return max_depth > math_bytecode::max_stack;
+        }
+
+    private:
+        math_bytecode &bc;
+        int depth = 0;
+        int max_depth = 0;
+
+        void add( math_bytecode::instr const &ins, int stack_delta ) {
+            bc.code.emplace_back( ins );
+            depth += stack_delta;
+            max_depth = std::max( max_depth, depth );
+        }
+
+        void push( double v ) {
+            math_bytecode::instr ins;
+            ins.val = v;
+            add( ins, 1 );
+        }
+
+        // the code emitted since start is a run of n constants
+        bool is_const_run( std::size_t start, std::size_t n ) const {
+            return bc.code.size() - start == n &&
+            std::all_of( bc.code.begin() + start, bc.code.end(), []( math_bytecode::instr const & i ) {
+                return i.op == math_bytecode::opcode::push;
+            } );
+        }
+
+        // replace the constant run since start with a single constant
+        void fold( std::size_t start, double v ) {
+            depth -= static_cast<int>( bc.code.size() - start );
+            bc.code.resize( start );
+            push( v );
+        }
+
+        int slot_for( var_info const &vi ) {
+            auto const it = std::find_if( bc.vars.begin(), bc.vars.end(), [&vi]( var_info const & e ) {
+                return e.type == vi.type && e.name == vi.name;
+            } );
+            if( it != bc.vars.end() ) {
+                return static_cast<int>( it - bc.vars.begin() );
+            }
+            // intern the name now so evaluation doesn't have to
+            bc.vars.emplace_back( vi ).key();
+            return static_cast<int>( bc.vars.size() - 1 );
+        }
+
+        bool emit_oper( oper const &v ) {
+            std::size_t const start = bc.code.size();
+            if( !emit( *v.l ) || !emit( *v.r ) ) {
+                return false;
+            }
+            if( is_const_run( start, 2 ) ) {
+                fold( start, v.op( bc.code[start].val, bc.code[start + 1].val ) );
+                return true;
+            }
+            math_bytecode::instr ins;
+            ins.op = math_bytecode::opcode::bin_op;
+            ins.bin = v.op;
+            add( ins, -1 );
+            return true;
+        }
+
+        bool emit_params( std::vector<thingie> const &params ) {
+            return std::all_of( params.begin(), params.end(), [this]( thingie const & p ) {
+                return emit( p );
+            } );
+        }
+
+        bool emit_func( func const &v ) {
+            std::size_t const start = bc.code.size();
+            if( !emit_params( v.params ) ) {
+                return false;
+            }
+            int const nargs = static_cast<int>( v.params.size() );
+            if( v.pure && is_const_run( start, v.params.size() ) ) {
+                std::vector<double> args;
+                args.reserve( v.params.size() );
+                for( std::size_t i = start; i < bc.code.size(); i++ ) {
+                    args.emplace_back( bc.code[i].val );
+                }
+                fold( start, v.f( args ) );
+                return true;
+            }
+            math_bytecode::instr ins;
+            ins.op = math_bytecode::opcode::call;
+            ins.nargs = nargs;
+            ins.fn = v.f;
+            add( ins, 1 - nargs );
+            return true;
+        }
+
+        bool emit_jmath( func_jmath const &v ) {
+            if( !emit_params( v.params ) ) {
+                return false;
+            }
+            int const nargs = static_cast<int>( v.params.size() );
+            math_bytecode::instr ins;
+            ins.op = math_bytecode::opcode::call_jmath;
+            ins.idx = static_cast<int>( bc.jmaths.size() );
+            ins.nargs = nargs;
+            bc.jmaths.emplace_back( v.id );
+            add( ins, 1 - nargs );
+            return true;
+        }
+
+        bool emit_ternary( ternary const &v ) {
+            std::size_t const start = bc.code.size();
+            if( !emit( *v.cond ) ) {
+                return false;
+            }
+            if( is_const_run( start, 1 ) ) {
+                bool const cond = bc.code[start].val > 0;
+                bc.code.resize( start );
+                depth--;
+                return emit( cond ? *v.mhs : *v.rhs );
+            }
+            std::size_t const jif = bc.code.size();
+            add( { math_bytecode::opcode::jump_if_false }, -1 );
+            if( !emit( *v.mhs ) ) {
+                return false;
+            }
+            std::size_t const jmp = bc.code.size();
+            add( { math_bytecode::opcode::jump }, 0 );
+            // the middle operand's result is not on the stack when the right one runs
+            depth--;
+            bc.code[jif].idx = static_cast<int>( bc.code.size() );
+            if( !emit( *v.rhs ) ) {
+                return false;
+            }
+            bc.code[jmp].idx = static_cast<int>( bc.code.size() );
+            return true;
+        }
+};
+
 } // namespace
 
-func::func( std::vector<thingie> &&params_, math_func::f_t f_ ) : params( params_ ),
-    f( f_ ) {}
+bool math_bytecode::compile( thingie const &tree )
+{
+    *this = {};
+    bytecode_compiler comp( *this );
+    if( !comp.emit( tree ) || comp.overflowed() ) {
+        *this = {};
+        return false;
+    }
+    return true;
+}
+
+double math_bytecode::eval( dialogue &d ) const
+{
+    std::array<double, max_stack> stack;
+    int sp = 0;
+    std::size_t pc = 0;
+    while( pc < code.size() ) {
+        instr const &ins = code[pc++];
+        switch( ins.op ) {
+            case opcode::push:
+                stack[sp++] = ins.val;
+                break;
+            case opcode::load_var:
+                stack[sp++] = _read_var_dbl( vars[ins.idx], d );
+                break;
+            case opcode::bin_op:
+                sp--;
+                stack[sp - 1] = ins.bin( stack[sp - 1], stack[sp] );
+                break;
+            case opcode::call:
+                sp -= ins.nargs;
+                stack[sp] = ins.fn( math_params( stack.data() + sp, ins.nargs ) );
+                sp++;
+                break;
+            case opcode::call_jmath:
+                sp -= ins.nargs;
+                stack[sp] = jmaths[ins.idx]->eval( d, math_params( stack.data() + sp, ins.nargs ) );
+                sp++;
+                break;
+            case opcode::call_diag:
+                stack[sp++] = diags[ins.idx].eval( d );
+                break;
+            case opcode::jump_if_false:
+                sp--;
+                if( !( stack[sp] > 0 ) ) {
+                    pc = ins.idx;
+                }
+                break;
+            case opcode::jump:
+                pc = ins.idx;
+                break;
+        }
+    }
+    return stack[0];
+}
+
+func::func( std::vector<thingie> &&params_, math_func::f_t f_, bool pure_ ) : params( params_ ),
+    f( f_ ), pure( pure_ ) {}
 func_jmath::func_jmath( std::vector<thingie> &&params_,
                         jmath_func_id const &id_ ) : params( params_ ),
     id( id_ ) {}
@@ -231,15 +490,7 @@ double func_jmath::eval( dialogue &d ) const
 
 double var::eval( dialogue &d ) const
 {
-    std::string const str = read_var_value( varinfo, d );
-    if( str.empty() ) {
-        return 0;
-    }
-    if( std::optional<double> ret = svtod( str ); ret ) {
-        return *ret;
-    }
-    debugmsg( R"(failed to convert variable "%s" with value "%s" to a number)", varinfo.name, str );
-    return 0;
+    return _read_var_dbl( varinfo, d );
 }
 
 oper::oper( thingie l_, thingie r_, binary_op::f_t op_ ):
@@ -270,7 +521,9 @@ class math_exp::math_exp_impl
 {
     public:
         math_exp_impl() = default;
-        explicit math_exp_impl( thingie &&t ): tree( t ) {}
+        explicit math_exp_impl( thingie &&t ): tree( t ) {
+            bytecode.compile( tree );
+        }
 
         bool parse( std::string_view str, bool assignment ) {
             if( str.empty() ) {
@@ -288,11 +541,19 @@ class math_exp::math_exp_impl
                 output = {};
                 arity = {};
                 tree = thingie { 0.0 };
+                bytecode = {};
                 return false;
             }
+            bytecode.compile( tree );
             return true;
         }
         double eval( dialogue &d ) const {
+            if( bytecode.empty() ) {
+                return tree.eval( d );
+            }
+            return bytecode.eval( d );
+        }
+        double eval_tree( dialogue &d ) const {
             return tree.eval( d );
         }
 
@@ -302,8 +563,7 @@ class math_exp::math_exp_impl
                     v.assign( d, val );
                 },
                 [&d, val]( var const & v ) {
-                    write_var_value( v.varinfo.type, v.varinfo.name,
-                                     &d, val );
+                    write_var_value( v.varinfo.type, v.varinfo.key(), &d, var_value( val ) );
                 },
                 []( auto &/* v */ ) {
                     debugmsg( "Assignment called on eval tree" );
@@ -337,6 +597,7 @@ class math_exp::math_exp_impl
         };
         std::stack<arity_t> arity;
         thingie tree{ 0.0 };
+        math_bytecode bytecode;
         std::string_view last_token;
         parse_state state;
 
@@ -621,7 +882,7 @@ void math_exp::math_exp_impl::new_func()
             },
             [&params, this]( pmath_func v )
             {
-                output.emplace( std::in_place_type_t<func>(), std::move( params ), v->f );
+                output.emplace( std::in_place_type_t<func>(), std::move( params ), v->f, v->pure );
             },
             [&params, this]( jmath_func_id const & v )
             {
@@ -860,6 +1121,11 @@ double math_exp::eval( dialogue &d ) const
     return impl->eval( d );
 }
 
+double math_exp::eval_tree( dialogue &d ) const
+{
+    return impl->eval_tree( d );
+}
+
 void math_exp::assign( dialogue &d, double val ) const
 {
     return impl->assign( d, val );
@@ -22,6 +22,9 @@ class math_exp
 
         bool parse( std::string_view str, bool assignment = false );
         double eval( dialogue &d ) const;
+        // evaluate by walking the parse tree instead of running the compiled bytecode.
+        // Only useful for testing and benchmarking the compiler
+        double eval_tree( dialogue &d ) const;
         void assign( dialogue &d, double val ) const;
 
     private:
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <string>
 #include <string_view>
@@ -13,11 +14,43 @@
 #include "rng.h"
 #include "units.h"
 
+// non-owning view of evaluated function arguments, so that the bytecode evaluator can pass
+// a slice of its operand stack without copying it into a vector
+class math_params
+{
+    public:
+        math_params( double const *first, std::size_t count ) : first_( first ), count_( count ) {}
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        math_params( std::vector<double> const &v ) : first_( v.data() ), count_( v.size() ) {}
+
+        double const *begin() const {
+            return first_;
+        }
+        double const *end() const {
+            return first_ + count_;
+        }
+        std::size_t size() const {
+            return count_;
+        }
+        bool empty() const {
+            return count_ == 0;
+        }
+        double operator[]( std::size_t i ) const {
+            return first_[i];
+        }
+
+    private:
+        double const *first_;
+        std::size_t count_;
+};
+
 struct math_func {
     std::string_view symbol;
     int num_params;
-    using f_t = double ( * )( std::vector<double> const & );
+    using f_t = double ( * )( math_params const & );
     f_t f;
+    // false for functions whose result may differ between calls with the same arguments
+    bool pure = true;
 };
 using pmath_func = math_func const *;
 
@@ -27,12 +60,12 @@ struct math_const {
 };
 using pmath_const = math_const const *;
 
-inline double abs( std::vector<double> const &params )
+inline double abs( math_params const &params )
 {
     return std::abs( params[0] );
 }
 
-inline double max( std::vector<double> const &params )
+inline double max( math_params const &params )
 {
     if( params.empty() ) {
         return 0;
@@ -40,7 +73,7 @@ inline double max( std::vector<double> const &params )
     return *std::max_element( params.begin(), params.end() );
 }
 
-inline double min( std::vector<double> const &params )
+inline double min( math_params const &params )
 {
     if( params.empty() ) {
         return 0;
@@ -48,42 +81,42 @@ inline double min( std::vector<double> const &params )
     return *std::min_element( params.begin(), params.end() );
 }
 
-inline double math_rng( std::vector<double> const &params )
+inline double math_rng( math_params const &params )
 {
     return rng_float( params[0], params[1] );
 }
 
-inline double rand( std::vector<double> const &params )
+inline double rand( math_params const &params )
 {
     return rng( 0, static_cast<int>( std::round( params[0] ) ) );
 }
 
-inline double sqrt( std::vector<double> const &params )
+inline double sqrt( math_params const &params )
 {
     return std::sqrt( params[0] );
 }
 
-inline double log( std::vector<double> const &params )
+inline double log( math_params const &params )
 {
     return std::log( params[0] );
 }
 
-inline double sin( std::vector<double> const &params )
+inline double sin( math_params const &params )
 {
     return std::sin( params[0] );
 }
 
-inline double cos( std::vector<double> const &params )
+inline double cos( math_params const &params )
 {
     return std::cos( params[0] );
 }
 
-inline double tan( std::vector<double> const &params )
+inline double tan( math_params const &params )
 {
     return std::tan( params[0] );
 }
 
-inline double clamp( std::vector<double> const &params )
+inline double clamp( math_params const &params )
 {
     if( params[2] < params[1] ) {
         debugmsg( "clamp called with hi < lo (%f < %f)", params[2], params[1] );
@@ -92,47 +125,47 @@ inline double clamp( std::vector<double> const &params )
     return std::clamp( params[0], params[1], params[2] );
 }
 
-inline double floor( std::vector<double> const &params )
+inline double floor( math_params const &params )
 {
     return std::floor( params[0] );
 }
 
-inline double ceil( std::vector<double> const &params )
+inline double ceil( math_params const &params )
 {
     return std::ceil( params[0] );
 }
 
-inline double trunc( std::vector<double> const &params )
+inline double trunc( math_params const &params )
 {
     return std::trunc( params[0] );
 }
 
-inline double round( std::vector<double> const &params )
+inline double round( math_params const &params )
 {
     return std::round( params[0] );
 }
 
-constexpr double test_( std::vector<double> const &/* params */ )
+constexpr double test_( math_params const &/* params */ )
 {
     return 42;
 }
 
-inline double celsius_from_kelvin( std::vector<double> const &params )
+inline double celsius_from_kelvin( math_params const &params )
 {
     return units::to_celsius( units::from_kelvin( params[0] ) );
 }
 
-inline double fahrenheit_from_kelvin( std::vector<double> const &params )
+inline double fahrenheit_from_kelvin( math_params const &params )
 {
     return units::to_fahrenheit( units::from_kelvin( params[0] ) );
 }
 
-inline double celsius_to_kelvin( std::vector<double> const &params )
+inline double celsius_to_kelvin( math_params const &params )
 {
     return units::to_kelvin( units::from_celsius( params[0] ) );
 }
 
-inline double fahrenheit_to_kelvin( std::vector<double> const &params )
+inline double fahrenheit_to_kelvin( math_params const &params )
 {
     return units::to_kelvin( units::from_fahrenheit( params[0] ) );
 }
@@ -146,8 +179,8 @@ constexpr std::array<math_func, 20> functions{
     math_func{ "trunc", 1, trunc },
     math_func{ "ceil", 1, ceil },
     math_func{ "round", 1, round },
-    math_func{ "rng", 2, math_rng },
-    math_func{ "rand", 1, rand },
+    math_func{ "rng", 2, math_rng, false },
+    math_func{ "rand", 1, rand, false },
     math_func{ "sqrt", 1, sqrt },
     math_func{ "log", 1, log },
     math_func{ "sin", 1, sin },
@@ -65,12 +65,13 @@ struct oper {
     binary_op::f_t op{};
 };
 struct func {
-    explicit func( std::vector<thingie> &&params_, math_func::f_t f_ );
+    explicit func( std::vector<thingie> &&params_, math_func::f_t f_, bool pure_ = true );
 
     double eval( dialogue &d ) const;
 
     std::vector<thingie> params;
     math_func::f_t f{};
+    bool pure = true;
 };
 struct func_jmath {
     explicit func_jmath( std::vector<thingie> &&params_, jmath_func_id const &id_ );
@@ -179,6 +180,43 @@ constexpr double thingie::eval( dialogue &d ) const
     data );
 }
 
+// Flat stack-machine form of a parse tree.  Constant subexpressions are folded at compile
+// time and variables are resolved to slots, so evaluation is a single pass over a vector
+// that keeps its operands in a fixed-size array on the C++ stack.
+struct math_bytecode {
+    enum class opcode : int {
+        push = 0,      // push constant
+        load_var,      // push value of vars[idx]
+        bin_op,        // pop r, pop l, push bin( l, r )
+        call,          // pop nargs values, push fn( values )
+        call_jmath,    // pop nargs values, push jmaths[idx]( values )
+        call_diag,     // push diags[idx]( d )
+        jump_if_false, // pop cond, jump to idx if cond <= 0
+        jump,          // jump to idx
+    };
+    struct instr {
+        opcode op = opcode::push;
+        int idx = 0;
+        int nargs = 0;
+        double val = 0;
+        binary_op::f_t bin = nullptr;
+        math_func::f_t fn = nullptr;
+    };
+    static constexpr int max_stack = 64;
+
+    // returns false (and leaves the bytecode empty) if the tree can't be compiled
+    bool compile( thingie const &tree );
+    double eval( dialogue &d ) const;
+    bool empty() const {
+        return code.empty();
+    }
+
+    std::vector<instr> code;
+    std::vector<var_info> vars;
+    std::vector<jmath_func_id> jmaths;
+    std::vector<func_diag_eval> diags;
+};
+
 using op_t =
     std::variant<pbin_op, punary_op, pmath_func, jmath_func_id, scoped_diag_eval, scoped_diag_ass, paren>;
 
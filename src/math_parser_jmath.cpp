@@ -1,5 +1,6 @@
 #include "math_parser_jmath.h"
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 
@@ -8,6 +9,7 @@
 #include "generic_factory.h"
 #include "math_parser.h"
 #include "math_parser_diag.h"
+#include "math_parser_func.h"
 
 namespace
 {
@@ -74,10 +76,10 @@ double jmath_func::eval( dialogue &d ) const
     return _exp.eval( d );
 }
 
-double jmath_func::eval( dialogue &d, std::vector<double> const &params ) const
+double jmath_func::eval( dialogue &d, math_params const &params ) const
 {
     dialogue d_next( d );
-    for( std::vector<double>::size_type i = 0; i < params.size(); i++ ) {
+    for( std::size_t i = 0; i < params.size(); i++ ) {
         write_var_value( var_type::context, "npctalk_var_" + std::to_string( i ), &d_next, params[i] );
     }
 
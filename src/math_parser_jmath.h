@@ -10,6 +10,7 @@
 #include "type_id.h"
 
 class JsonObject;
+class math_params;
 struct dialogue;
 
 struct jmath_func {
@@ -19,7 +20,7 @@ struct jmath_func {
     int num_params{};
 
     double eval( dialogue &d ) const;
-    double eval( dialogue &d, std::vector<double> const &params ) const;
+    double eval( dialogue &d, math_params const &params ) const;
 
     void load( const JsonObject &jo, std::string_view src );
     static void load_func( const JsonObject &jo, std::string const &src );
@@ -40,6 +40,7 @@
 #include "options.h"
 #include "pathfinding.h"
 #include "pimpl.h"
+#include "profiler.h"
 #include "rng.h"
 #include "scent_map.h"
 #include "sounds.h"
@@ -890,8 +891,9 @@ void monster::move()
     // TODO: Create a special attacks whitelist unordered map instead of an if chain.
     std::map<std::string, mtype_special_attack>::const_iterator attack =
         type->special_attacks.find( action );
-    if( attack != type->special_attacks.end() && attack->second->call( *this ) ) {
-        if( special_attacks.count( action ) != 0 ) {
+    if( attack != type->special_attacks.end() ) {
+        profiler::scope prof( profiler::category::monster_special, action );
+        if( attack->second->call( *this ) && special_attacks.count( action ) != 0 ) {
             reset_special( action );
         }
     }
@@ -922,6 +924,7 @@ void monster::move()
         // Cooldowns are decremented in monster::process_turn
 
         if( local_attack_data.cooldown == 0 && !pacified && !is_hallucination() ) {
+            profiler::scope prof( profiler::category::monster_special, special_name );
             if( !sp_type.second->call( *this ) ) {
                 add_msg_debug( debugmode::DF_MATTACK, "Attack failed" );
                 continue;
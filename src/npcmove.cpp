@@ -34,6 +34,7 @@
 #include "enums.h"
 #include "event_bus.h"
 #include "explosion.h"
+#include "faction.h"
 #include "field.h"
 #include "field_type.h"
 #include "flag.h"
@@ -337,6 +338,7 @@ tripoint npc::good_escape_direction( bool include_pos )
 
     std::vector<tripoint> candidates;
 
+    const faction *fac = get_faction();
     const auto rate_pt = [&]( const tripoint & pt, const float threat_val ) {
         if( !can_move_to( pt, !rules.has_flag( ally_rule::allow_bash ) ) ) {
             add_msg_debug( debugmode::DF_NPC_MOVEAI,
@@ -345,6 +347,10 @@ tripoint npc::good_escape_direction( bool include_pos )
             return MAX_FLOAT;
         }
         float rating = threat_val;
+        if( fac != nullptr ) {
+            // threats spotted by the rest of the faction count too
+            rating += fac->threats.danger_at( here.getglobal( pt ) );
+        }
         for( const auto &e : here.field_at( pt ) ) {
             if( is_dangerous_field( e.second ) ) {
                 // Note, field danger should be rated more specifically than this,
@@ -710,6 +716,7 @@ void npc::assess_danger()
     int friendly_count = 1; // count yourself as a friendly
     int def_radius = rules.has_flag( ally_rule::follow_close ) ? follow_distance() : 6;
     bool npc_ranged = get_wielded_item() && get_wielded_item()->is_gun();
+    faction *fac = get_faction();
 
     if( !confident_range_cache ) {
         invalidate_range_cache();
@@ -859,6 +866,9 @@ void npc::assess_danger()
 
         if( is_enemy() || !critter.friendly ) {
             mem_combat.assess_enemy += critter_threat;
+            if( fac != nullptr ) {
+                fac->threats.add( critter, critter.get_location() );
+            }
             if( critter_threat > ( 8.0f + personality.bravery + rng( 0, 5 ) ) ) {
                 warn_about( "monster", 10_minutes, critter.type->nname(), dist, critter.pos() );
             }
@@ -943,6 +953,9 @@ void npc::assess_danger()
         if( foe_threat > ( 8.0f + personality.bravery + rng( 0, 5 ) ) ) {
             warn_about( "monster", 10_minutes, bogey, dist, foe.pos() );
         }
+        if( fac != nullptr ) {
+            fac->threats.add( foe, foe.get_location() );
+        }
 
         int scaled_distance = std::max( 1, ( 100 * dist ) / foe.get_speed() );
         ai_cache.total_danger += foe_threat / scaled_distance;
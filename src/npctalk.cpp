@@ -3712,7 +3712,7 @@ talk_effect_fun_t::func f_location_variable( const JsonObject &jo, std::string_v
             target_pos = target_pos + tripoint( 0, 0,
                                                 dov_z_adjust.evaluate( d ) );
         }
-        write_var_value( type, var_name, &d, target_pos.to_string() );
+        write_var_value( type, var_key( var_name ), &d, var_value( tripoint_abs_ms( target_pos ) ) );
         run_eoc_vector( true_eocs, d );
     };
 }
@@ -3749,9 +3749,9 @@ talk_effect_fun_t::func f_location_variable_adjust( const JsonObject &jo,
             target_pos = target_pos + tripoint( 0, 0, dov_z_adjust.evaluate( d ) );
         }
         if( output_var.has_value() ) {
-            write_var_value( output_var.value().type, output_var.value().name, &d, target_pos.to_string() );
+            write_var_value( output_var.value().type, output_var.value().key(), &d, var_value( target_pos ) );
         } else {
-            write_var_value( input_var.value().type, input_var.value().name,   &d, target_pos.to_string() );
+            write_var_value( input_var.value().type, input_var.value().key(), &d, var_value( target_pos ) );
         }
     };
 }
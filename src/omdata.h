@@ -578,7 +578,7 @@ class overmap_special
         }
         int longest_side() const;
         std::vector<overmap_special_terrain> preview_terrains() const;
-        std::vector<overmap_special_locations> required_locations() const;
+        const std::vector<overmap_special_locations> &required_locations() const;
         int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                om_direction::type r ) const;
         special_placement_result place(
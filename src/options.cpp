@@ -2804,6 +2804,11 @@ void options_manager::add_options_world_default()
          true
        );
 
+    add( "SOUND_OCCLUSION", "world_default", to_translation( "Walls muffle sounds" ),
+         to_translation( "If true, sounds reach monsters around walls and closed doors, and are much quieter when they have to pass through them.  If false, sounds reach every monster in a straight line." ),
+         false
+       );
+
     add_empty_line();
 
     add( "CHARACTER_POINT_POOLS", "world_default", to_translation( "Character point pools" ),
@@ -2898,6 +2903,13 @@ void options_manager::add_options_debug()
 
     add_empty_line();
 
+    add( "TURN_TIME_BUDGET", "debug", to_translation( "Turn time budget" ),
+         to_translation( "When a turn takes longer than this many milliseconds, not counting the time spent waiting for input, the time and allocations of each part of the turn are appended to slow_turns.csv.  Set to 0 to disable." ),
+         0, 10000, 0
+       );
+
+    add_empty_line();
+
     add_option_group( "debug", Group( "occlusion_opts", to_translation( "Occlusion Options" ),
                                       to_translation( "Options regarding occlusion." ) ),
     [&]( const std::string & page_id ) {
@@ -4083,6 +4095,7 @@ void options_manager::update_options_cache()
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    turn_time_budget = ::get_option<int>( "TURN_TIME_BUDGET" );
     keycode_mode = ::get_option<std::string>( "SDL_KEYBOARD_MODE" ) == "keycode";
     use_pinyin_search = ::get_option<bool>( "USE_PINYIN_SEARCH" );
 
@@ -1193,7 +1193,7 @@ struct overmap_special_data {
         mapgen_parameters &, const std::string &context ) const = 0;
     virtual void check( const std::string &context ) const = 0;
     virtual std::vector<overmap_special_terrain> preview_terrains() const = 0;
-    virtual std::vector<overmap_special_locations> required_locations() const = 0;
+    virtual const std::vector<overmap_special_locations> &required_locations() const = 0;
     virtual int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                    om_direction::type r ) const = 0;
     virtual special_placement_result place(
@@ -1204,7 +1204,7 @@ struct overmap_special_data {
 struct fixed_overmap_special_data : overmap_special_data {
     fixed_overmap_special_data() = default;
     explicit fixed_overmap_special_data( const overmap_special_terrain &ter )
-        : terrains{ ter }
+        : terrains{ ter }, locations{ ter }
     {}
 
     void finalize(
@@ -1217,6 +1217,7 @@ struct fixed_overmap_special_data : overmap_special_data {
                 t.locations = default_locations;
             }
         }
+        locations.assign( terrains.begin(), terrains.end() );
 
         for( overmap_special_connection &elem : connections ) {
             const overmap_special_terrain &oter = get_terrain_at( elem.p );
@@ -1381,11 +1382,8 @@ struct fixed_overmap_special_data : overmap_special_data {
         return result;
     }
 
-    std::vector<overmap_special_locations> required_locations() const override {
-        std::vector<overmap_special_locations> result;
-        result.reserve( terrains.size() );
-        std::copy( terrains.begin(), terrains.end(), std::back_inserter( result ) );
-        return result;
+    const std::vector<overmap_special_locations> &required_locations() const override {
+        return locations;
     }
 
     int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
@@ -1467,6 +1465,9 @@ struct fixed_overmap_special_data : overmap_special_data {
 
     std::vector<overmap_special_terrain> terrains;
     std::vector<overmap_special_connection> connections;
+    // The locations of terrains, copied by finalize since they are checked for every
+    // candidate position while placing specials
+    std::vector<overmap_special_locations> locations;
 };
 
 struct mutable_overmap_join {
@@ -2491,7 +2492,7 @@ struct mutable_overmap_special_data : overmap_special_data {
         return std::vector<overmap_special_terrain> { root_as_overmap_special_terrain() };
     }
 
-    std::vector<overmap_special_locations> required_locations() const override {
+    const std::vector<overmap_special_locations> &required_locations() const override {
         return check_for_locations;
     }
 
@@ -2680,7 +2681,7 @@ int overmap_special::longest_side() const
 {
     // Figure out the longest side of the special for purposes of determining our sector size
     // when attempting placements.
-    std::vector<overmap_special_locations> req_locations = required_locations();
+    const std::vector<overmap_special_locations> &req_locations = required_locations();
     auto min_max_x = std::minmax_element( req_locations.begin(), req_locations.end(),
     []( const overmap_special_locations & lhs, const overmap_special_locations & rhs ) {
         return lhs.p.x < rhs.p.x;
@@ -2701,7 +2702,7 @@ std::vector<overmap_special_terrain> overmap_special::preview_terrains() const
     return data_->preview_terrains();
 }
 
-std::vector<overmap_special_locations> overmap_special::required_locations() const
+const std::vector<overmap_special_locations> &overmap_special::required_locations() const
 {
     return data_->required_locations();
 }
@@ -2920,6 +2921,7 @@ void overmap::init_layers()
         l.visible.fill( false );
         l.explored.fill( false );
     }
+    terrain_chunks_dirty = true;
 }
 
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
@@ -2960,9 +2962,54 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         // We had a predecessor, and it was the same type as the incoming one
         // Don't push another copy.
     }
+    if( placement_index.active && p.z() == 0 && current_oter != id ) {
+        update_placement_index( p.xy(), current_oter, id );
+    }
+    if( !terrain_chunks_dirty && current_oter != id ) {
+        const tripoint_om_omt chunk( p.x() - p.x() % terrain_chunk_size,
+                                     p.y() - p.y() % terrain_chunk_size, p.z() );
+        std::vector<tripoint_om_omt> &chunks = terrain_chunks_[id];
+        if( std::find( chunks.begin(), chunks.end(), chunk ) == chunks.end() ) {
+            chunks.push_back( chunk );
+        }
+    }
     current_oter = id;
 }
 
+const std::unordered_map<oter_id, std::vector<tripoint_om_omt>> &overmap::terrain_chunks()
+{
+    static_assert( OMAPX % terrain_chunk_size == 0 && OMAPY % terrain_chunk_size == 0,
+                   "overmaps must be made of whole terrain chunks" );
+    if( !terrain_chunks_dirty ) {
+        return terrain_chunks_;
+    }
+    terrain_chunks_.clear();
+    std::unordered_set<oter_id> in_chunk;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int cx = 0; cx < OMAPX; cx += terrain_chunk_size ) {
+            for( int cy = 0; cy < OMAPY; cy += terrain_chunk_size ) {
+                in_chunk.clear();
+                oter_id last;
+                for( int x = cx; x < cx + terrain_chunk_size; x++ ) {
+                    for( int y = cy; y < cy + terrain_chunk_size; y++ ) {
+                        const oter_id &here = ter_unsafe( tripoint_om_omt( x, y, z ) );
+                        // Terrain comes in runs, most tiles are the same as the one before
+                        if( here != last ) {
+                            in_chunk.insert( here );
+                            last = here;
+                        }
+                    }
+                }
+                for( const oter_id &id : in_chunk ) {
+                    terrain_chunks_[id].emplace_back( cx, cy, z );
+                }
+            }
+        }
+    }
+    terrain_chunks_dirty = false;
+    return terrain_chunks_;
+}
+
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
@@ -3394,6 +3441,7 @@ void overmap::generate( const overmap *north, const overmap *east,
                     layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
                 }
             }
+            terrain_chunks_dirty = true;
         }
     }
     calculate_urbanity();
@@ -3917,6 +3965,7 @@ void overmap::process_mongroups()
         }
         if( mg.empty() ) {
             zg.erase( it++ );
+            invalidate_horde_index();
         } else {
             ++it;
         }
@@ -3926,6 +3975,7 @@ void overmap::process_mongroups()
 void overmap::clear_mon_groups()
 {
     zg.clear();
+    invalidate_horde_index();
 }
 
 void overmap::clear_overmap_special_placements()
@@ -4022,8 +4072,9 @@ void mongroup::wander( const overmap &om )
 
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
+    // Prevent hordes to be moved twice by putting them in here after moving.  Only the nodes
+    // are taken out of the map, the groups and their monsters aren't copied.
+    std::vector<decltype( zg )::node_type> moved;
     //MOVE ZOMBIE GROUPS
     for( auto it = zg.begin(); it != zg.end(); ) {
         mongroup &mg = it->second;
@@ -4079,15 +4130,20 @@ void overmap::move_hordes()
                 mg.abs_pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.emplace( mg.rel_pos(), mg );
-            zg.erase( it++ );
+            // Take the group out of its old location, it's put back at the new location below
+            moved.emplace_back( zg.extract( it++ ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    for( decltype( zg )::node_type &node : moved ) {
+        node.key() = node.mapped().rel_pos();
+        zg.insert( std::move( node ) );
+    }
+    if( !moved.empty() ) {
+        invalidate_horde_index();
+    }
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -4205,6 +4261,7 @@ void overmap::move_nemesis()
 
         //update the nemesis coordinates in abs_sm for movement across overmaps
         if( one_in( movement_chance ) && rng( 0, 200 ) < mg.avg_speed() ) {
+            invalidate_horde_index();
             if( mg.abs_pos.x() > mg.nemesis_target.x() ) {
                 mg.abs_pos.x()--;
             }
@@ -4251,6 +4308,7 @@ bool overmap::remove_nemesis()
         mongroup &mg = it->second;
         if( mg.behaviour == mongroup::horde_behaviour::nemesis ) {
             zg.erase( it++ );
+            invalidate_horde_index();
             return true;
         }
         it++;
@@ -4258,6 +4316,21 @@ bool overmap::remove_nemesis()
     return false;
 }
 
+// Width in submaps of the squares hordes are bucketed into for signal_hordes
+static constexpr int horde_index_bucket_size = 12;
+
+void overmap::rebuild_horde_index()
+{
+    hordes.buckets.clear();
+    for( std::pair<const tripoint_om_sm, mongroup> &elem : zg ) {
+        const point p = elem.second.abs_pos.xy().raw();
+        const point bucket( divide_round_down( p.x, horde_index_bucket_size ),
+                            divide_round_down( p.y, horde_index_bucket_size ) );
+        hordes.buckets[bucket].push_back( &elem.second );
+    }
+    hordes.dirty = false;
+}
+
 /**
 * @param p location of signal relative to this overmap origin
 * @param sig_power - power of signal or max distance for reaction of zombies
@@ -4266,8 +4339,26 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
     tripoint_om_sm p( p_rel.raw() );
     tripoint_abs_sm absp = project_combine( pos(), p );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    if( hordes.dirty ) {
+        rebuild_horde_index();
+    }
+    // Only the buckets overlapping the square around the signal can have hordes within range
+    std::vector<mongroup *> in_range;
+    const point center = absp.xy().raw();
+    const point min_bucket( divide_round_down( center.x - sig_power, horde_index_bucket_size ),
+                            divide_round_down( center.y - sig_power, horde_index_bucket_size ) );
+    const point max_bucket( divide_round_down( center.x + sig_power, horde_index_bucket_size ),
+                            divide_round_down( center.y + sig_power, horde_index_bucket_size ) );
+    for( int x = min_bucket.x; x <= max_bucket.x; x++ ) {
+        for( int y = min_bucket.y; y <= max_bucket.y; y++ ) {
+            const auto bucket = hordes.buckets.find( point( x, y ) );
+            if( bucket != hordes.buckets.end() ) {
+                in_range.insert( in_range.end(), bucket->second.begin(), bucket->second.end() );
+            }
+        }
+    }
+    for( mongroup *mg_ptr : in_range ) {
+        mongroup &mg = *mg_ptr;
         if( !mg.horde ) {
             continue;
         }
@@ -6523,6 +6614,151 @@ om_direction::type om_direction::from_cube( cube_direction c, const std::string
     return om_direction::type::invalid;
 }
 
+// The trees of special_placement_index cover the ground level of the overmap, row by row
+static void fenwick_add( std::vector<int> &tree, const point_om_omt &p, const int delta )
+{
+    for( int x = p.x() + 1; x <= OMAPX; x += x & -x ) {
+        for( int y = p.y() + 1; y <= OMAPY; y += y & -y ) {
+            tree[( y - 1 ) * OMAPX + x - 1] += delta;
+        }
+    }
+}
+
+// Sum over the rectangle from the corner of the overmap to p, inclusive
+static int fenwick_sum( const std::vector<int> &tree, const point &p )
+{
+    int sum = 0;
+    for( int x = p.x + 1; x > 0; x -= x & -x ) {
+        for( int y = p.y + 1; y > 0; y -= y & -y ) {
+            sum += tree[( y - 1 ) * OMAPX + x - 1];
+        }
+    }
+    return sum;
+}
+
+static int fenwick_sum( const std::vector<int> &tree, const point &min, const point &max )
+{
+    return fenwick_sum( tree, max ) - fenwick_sum( tree, point( min.x - 1, max.y ) ) -
+           fenwick_sum( tree, point( max.x, min.y - 1 ) ) + fenwick_sum( tree, min - point_south_east );
+}
+
+void overmap::build_placement_index( const overmap_special_batch &specials )
+{
+    placement_index = special_placement_index();
+    std::map<cata::flat_set<overmap_location_id>, size_t> fit_of_locations;
+    for( const overmap_special_placement &elem : specials ) {
+        const overmap_special &special = *elem.special_details;
+        const auto inserted = placement_index.footprints.emplace( &special,
+                              std::vector<special_placement_index::footprint>() );
+        if( !inserted.second ) {
+            continue;
+        }
+        std::vector<special_placement_index::footprint> &footprints = inserted.first->second;
+        for( const overmap_special_locations &loc : special.required_locations() ) {
+            if( loc.p.z != 0 ) {
+                continue;
+            }
+            const auto fit = fit_of_locations.emplace( loc.locations, placement_index.fits.size() );
+            if( fit.second ) {
+                placement_index.fits.emplace_back( &loc, std::vector<int>() );
+            }
+            const auto fp = std::find_if( footprints.begin(), footprints.end(),
+            [&]( const special_placement_index::footprint & f ) {
+                return f.fit == fit.first->second;
+            } );
+            if( fp == footprints.end() ) {
+                footprints.push_back( { fit.first->second, 1, loc.p.xy(), loc.p.xy() } );
+            } else {
+                ++fp->tiles;
+                fp->min = point( std::min( fp->min.x, loc.p.x ), std::min( fp->min.y, loc.p.y ) );
+                fp->max = point( std::max( fp->max.x, loc.p.x ), std::max( fp->max.y, loc.p.y ) );
+            }
+        }
+    }
+
+    for( std::pair<const overmap_special_locations *, std::vector<int>> &fit : placement_index.fits ) {
+        std::vector<int> &tree = fit.second;
+        tree.resize( static_cast<size_t>( OMAPX ) * OMAPY );
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                tree[y * OMAPX + x] = fit.first->can_be_placed_on( ter_unsafe( { x, y, 0 } ) ) ? 1 : 0;
+            }
+        }
+        // Each node adds itself to its parent, along the rows and then along the columns
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 1; x <= OMAPX; x++ ) {
+                const int parent = x + ( x & -x );
+                if( parent <= OMAPX ) {
+                    tree[y * OMAPX + parent - 1] += tree[y * OMAPX + x - 1];
+                }
+            }
+        }
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 1; y <= OMAPY; y++ ) {
+                const int parent = y + ( y & -y );
+                if( parent <= OMAPY ) {
+                    tree[( parent - 1 ) * OMAPX + x] += tree[( y - 1 ) * OMAPX + x];
+                }
+            }
+        }
+    }
+    placement_index.nearest_city.assign( static_cast<size_t>( OMAPX ) * OMAPY,
+                                         special_placement_index::unknown_city );
+    placement_index.active = true;
+}
+
+void overmap::update_placement_index( const point_om_omt &p, const oter_id &from,
+                                      const oter_id &to )
+{
+    for( std::pair<const overmap_special_locations *, std::vector<int>> &fit : placement_index.fits ) {
+        const int delta = ( fit.first->can_be_placed_on( to ) ? 1 : 0 ) -
+                          ( fit.first->can_be_placed_on( from ) ? 1 : 0 );
+        if( delta != 0 ) {
+            fenwick_add( fit.second, p, delta );
+        }
+    }
+}
+
+bool overmap::may_fit_placement_index( const overmap_special &special,
+                                       const tripoint_om_omt &p, om_direction::type dir ) const
+{
+    if( !placement_index.active || p.z() != 0 ) {
+        return true;
+    }
+    const auto footprints = placement_index.footprints.find( &special );
+    if( footprints == placement_index.footprints.end() ) {
+        return true;
+    }
+    for( const special_placement_index::footprint &fp : footprints->second ) {
+        // Rotating the corners of the footprint's bounds gives the corners of the rotated bounds
+        const point a = p.xy().raw() + om_direction::rotate( fp.min, dir );
+        const point b = p.xy().raw() + om_direction::rotate( fp.max, dir );
+        const point min( std::min( a.x, b.x ), std::min( a.y, b.y ) );
+        const point max( std::max( a.x, b.x ), std::max( a.y, b.y ) );
+        if( !inbounds( tripoint_om_omt( min.x, min.y, 0 ), 1 ) ||
+            !inbounds( tripoint_om_omt( max.x, max.y, 0 ), 1 ) ) {
+            return false;
+        }
+        if( fenwick_sum( placement_index.fits[fp.fit].second, min, max ) < fp.tiles ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const city &overmap::placement_nearest_city( const tripoint_om_omt &p )
+{
+    if( !placement_index.active || p.z() != 0 || !inbounds( p ) ) {
+        return get_nearest_city( p );
+    }
+    int &nearest = placement_index.nearest_city[p.y() * OMAPX + p.x()];
+    if( nearest == special_placement_index::unknown_city ) {
+        const city &found = get_nearest_city( p );
+        nearest = found ? static_cast<int>( &found - cities.data() ) : -1;
+    }
+    return nearest < 0 ? get_nearest_city( p ) : cities[nearest];
+}
+
 om_direction::type overmap::random_special_rotation( const overmap_special &special,
         const tripoint_om_omt &p, const bool must_be_unexplored ) const
 {
@@ -6570,17 +6806,13 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
         overmap_buffer.contains_unique_special( special.id ) ) {
         return false;
     }
-
-    if( special.has_eoc() ) {
-        dialogue d( get_talker_for( get_avatar() ), nullptr );
-        if( !special.get_eoc()->test_condition( d ) ) {
-            return false;
-        }
+    if( !may_fit_placement_index( special, p, dir ) ) {
+        return false;
     }
 
-    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
+    const std::vector<overmap_special_locations> &fixed_terrains = special.required_locations();
 
-    return std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
+    const bool terrain_fits = std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
     [&]( const overmap_special_locations & elem ) {
         const tripoint_om_omt rp = p + om_direction::rotate( elem.p, dir );
 
@@ -6603,6 +6835,18 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
 
         return elem.can_be_placed_on( tid ) || ( rp.z() != 0 && tid == get_default_terrain( rp.z() ) );
     } );
+    if( !terrain_fits ) {
+        return false;
+    }
+
+    // Most positions are rejected by their terrain, so the condition is only checked after it
+    if( special.has_eoc() ) {
+        dialogue d( get_talker_for( get_avatar() ), nullptr );
+        if( !special.get_eoc()->test_condition( d ) ) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // checks around the selected point to see if the special can be placed there
@@ -6647,6 +6891,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
             tripoint_om_omt pos = project_to<coords::omt>( it->second.rel_pos() );
             if( safe_at_worldgen.find( pos ) != safe_at_worldgen.end() ) {
                 zg.erase( it++ );
+                invalidate_horde_index();
             } else {
                 ++it;
             }
@@ -6679,7 +6924,7 @@ bool overmap::place_special_attempt(
 
     const tripoint_om_omt p( rng( p2.x(), p2.x() + sector_width - 1 ),
                              rng( p2.y(), p2.y() + sector_width - 1 ), 0 );
-    const city &nearest_city = get_nearest_city( p );
+    const city &nearest_city = placement_nearest_city( p );
 
     std::shuffle( enabled_specials.begin(), enabled_specials.end(), rng_get_engine() );
     std::set<int> priorities;
@@ -6812,6 +7057,7 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
         return;
     }
     om_special_sectors sectors = get_sectors( OMSPEC_FREQ );
+    build_placement_index( enabled_specials );
 
     // First, place the mandatory specials to ensure that all minimum instance
     // counts are met.
@@ -6876,6 +7122,7 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
     }
     // Then fill in non-mandatory specials.
     place_specials_pass( enabled_specials, sectors, true, false );
+    placement_index = special_placement_index();
 
     // Clean up...
     // Because we passed a copy of the specials for placement in adjacent overmaps rather than
@@ -7227,6 +7474,7 @@ void overmap::spawn_mon_group( const mongroup &group, int radius )
 void overmap::add_mon_group( const mongroup &group )
 {
     zg.emplace( group.rel_pos(), group );
+    invalidate_horde_index();
 }
 
 void overmap::add_mon_group( const mongroup &group, int radius )
@@ -181,6 +181,59 @@ struct std::hash<pos_dir<Tripoint>> {
     }
 };
 
+/**
+ * The hordes of an overmap bucketed by their absolute position, for finding the hordes that
+ * hear a signal without looking at all of them.  It points into the overmap's groups, so a
+ * copy starts out empty and is rebuilt the next time it's used.
+ */
+struct horde_index {
+    std::unordered_map<point, std::vector<mongroup *>> buckets;
+    bool dirty = true;
+
+    horde_index() = default;
+    horde_index( const horde_index & ) {}
+    horde_index &operator=( const horde_index & ) {
+        buckets.clear();
+        dirty = true;
+        return *this;
+    }
+};
+
+struct overmap_special_locations;
+
+/**
+ * For the specials being placed, how many ground level tiles fit each set of locations they
+ * require, summed over rectangles with 2D Fenwick trees, and the nearest city of the tiles
+ * tried so far.  Lets most candidate positions be rejected by counting instead of testing
+ * every tile of the special.  Only built while specials are placed and kept up to date by
+ * ter_set meanwhile; a copy starts out empty.
+ */
+struct special_placement_index {
+    // Ground level tiles of a special needing one set of locations, before rotation
+    struct footprint {
+        size_t fit;
+        int tiles;
+        point min;
+        point max;
+    };
+    // A set of locations, and the Fenwick tree of the tiles that fit it
+    std::vector<std::pair<const overmap_special_locations *, std::vector<int>>> fits;
+    std::unordered_map<const overmap_special *, std::vector<footprint>> footprints;
+    // Index into the overmap's cities, -1 for none, or unknown_city
+    std::vector<int> nearest_city;
+    static constexpr int unknown_city = -2;
+    bool active = false;
+
+    special_placement_index() = default;
+    special_placement_index( const special_placement_index & ) {}
+    special_placement_index &operator=( const special_placement_index & ) {
+        *this = special_placement_index();
+        return *this;
+    }
+    special_placement_index( special_placement_index && ) = default;
+    special_placement_index &operator=( special_placement_index && ) = default;
+};
+
 class overmap
 {
     public:
@@ -231,6 +284,13 @@ class overmap
         const oter_id &ter( const tripoint_om_omt &p ) const;
         // ter_unsafe is UB when out of bounds.
         const oter_id &ter_unsafe( const tripoint_om_omt &p ) const;
+        /** Width of the square chunks in @ref terrain_chunks */
+        static constexpr int terrain_chunk_size = 12;
+        /**
+         * The corners of the chunks each terrain appears in, for searching for a terrain without
+         * looking at every tile.  A chunk may be listed for a terrain that was since replaced.
+         */
+        const std::unordered_map<oter_id, std::vector<tripoint_om_omt>> &terrain_chunks();
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_om_omt & );
         std::string *join_used_at( const om_pos_dir & );
         std::vector<oter_id> predecessors( const tripoint_om_omt & );
@@ -313,6 +373,23 @@ class overmap
                                    om_direction::type dir );
     private:
         std::multimap<tripoint_om_sm, mongroup> zg; // NOLINT(cata-serialize)
+        /** Hordes in @ref zg, must be invalidated whenever a group is added, removed or moved */
+        horde_index hordes; // NOLINT(cata-serialize)
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<oter_id, std::vector<tripoint_om_omt>> terrain_chunks_;
+        // Until the chunks are first built, and after the terrain is replaced wholesale
+        bool terrain_chunks_dirty = true; // NOLINT(cata-serialize)
+        /** Only active inside @ref place_specials */
+        special_placement_index placement_index; // NOLINT(cata-serialize)
+        void build_placement_index( const overmap_special_batch &specials );
+        void update_placement_index( const point_om_omt &p, const oter_id &from, const oter_id &to );
+        bool may_fit_placement_index( const overmap_special &special, const tripoint_om_omt &p,
+                                      om_direction::type dir ) const;
+        const city &placement_nearest_city( const tripoint_om_omt &p );
+        void invalidate_horde_index() {
+            hordes.dirty = true;
+        }
+        void rebuild_horde_index();
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
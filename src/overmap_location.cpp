@@ -32,6 +32,10 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const int_id<oter_t> &oter ) const
 {
+    const int index = oter.to_i();
+    if( index >= 0 && static_cast<size_t>( index ) < oter_matches.size() ) {
+        return oter_matches[index];
+    }
     return terrains.count( oter->get_type_id() );
 }
 
@@ -79,6 +83,16 @@ void overmap_location::finalize()
             }
         }
     }
+
+    // Testing locations dominates placing overmap specials, so look the answers up beforehand
+    oter_matches.clear();
+    for( const oter_t &ter_elem : overmap_terrains::get_all() ) {
+        const size_t index = ter_elem.id.id().to_i();
+        if( oter_matches.size() <= index ) {
+            oter_matches.resize( index + 1, false );
+        }
+        oter_matches[index] = terrains.count( ter_elem.get_type_id() ) > 0;
+    }
 }
 
 void overmap_locations::load( const JsonObject &jo, const std::string &src )
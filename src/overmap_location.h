@@ -32,6 +32,8 @@ struct overmap_location {
     private:
         TerrColType terrains;
         std::vector<std::string> flags;
+        // Result of test for each oter by its int id, filled by finalize
+        std::vector<bool> oter_matches;
 };
 
 namespace overmap_locations
@@ -6,6 +6,7 @@
 #include <list>
 #include <map>
 #include <optional>
+#include <queue>
 #include <string>
 #include <tuple>
 
@@ -79,6 +80,28 @@ cata_path overmapbuffer::player_filename( const point_abs_om &p )
     return PATH_INFO::player_base_save_path_path() + string_format( ".seen.%d.%d", p.x(), p.y() );
 }
 
+namespace
+{
+// Overmaps are generated from a stream seeded by the world and their position, so they
+// come out the same whether they are made ahead of time or when first needed, and the
+// game's own stream is left where it was.
+class overmap_generation_rng
+{
+    public:
+        explicit overmap_generation_rng( const point_abs_om &p ) : game_engine( rng_get_engine() ) {
+            rng_get_engine().seed( static_cast<cata_default_random_engine::result_type>(
+                                       g->get_seed() ^ std::hash<point_abs_om>()( p ) ) );
+        }
+        ~overmap_generation_rng() {
+            rng_get_engine() = game_engine;
+        }
+        overmap_generation_rng( const overmap_generation_rng & ) = delete;
+        overmap_generation_rng &operator=( const overmap_generation_rng & ) = delete;
+    private:
+        const cata_default_random_engine game_engine;
+};
+} // namespace
+
 overmap &overmapbuffer::get( const point_abs_om &p )
 {
     if( last_requested_overmap != nullptr && last_requested_overmap->pos() == p ) {
@@ -91,6 +114,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     }
 
     // That constructor loads an existing overmap or creates a new one.
+    const overmap_generation_rng rng( p );
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate();
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
@@ -102,6 +126,32 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     return new_om;
 }
 
+// How close to the edge of an overmap the overmap past it is made ahead of time
+static constexpr int generate_ahead_distance = OMAPX / 4;
+
+bool overmapbuffer::generate_ahead( const tripoint_abs_omt &p )
+{
+    point_abs_om om_pos;
+    point_om_omt local;
+    std::tie( om_pos, local ) = project_remain<coords::om>( p.xy() );
+    const auto near_edge = []( int dir, int pos, int size ) {
+        return dir == 0 || ( dir < 0 ? pos < generate_ahead_distance :
+                             pos >= size - generate_ahead_distance );
+    };
+    for( const tripoint &offset : eight_horizontal_neighbors ) {
+        if( !near_edge( offset.x, local.x(), OMAPX ) || !near_edge( offset.y, local.y(), OMAPY ) ) {
+            continue;
+        }
+        const point_abs_om next = om_pos + point_rel_om( offset.xy() );
+        if( overmaps.count( next ) > 0 ) {
+            continue;
+        }
+        get( next );
+        return true;
+    }
+    return false;
+}
+
 void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_special_batch &specials )
 {
     if( last_requested_overmap != nullptr ) {
@@ -110,6 +160,7 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
             last_requested_overmap = nullptr;
         }
     }
+    const overmap_generation_rng rng( p );
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate( specials );
 }
@@ -122,6 +173,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
             new_overmap.zg.erase( it++ );
+            new_overmap.invalidate_horde_index();
             continue;
         }
         // Inside the bounds of the overmap?
@@ -141,6 +193,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         overmap &om = get( omp );
         om.spawn_mon_group( mg, 1 );
         new_overmap.zg.erase( it++ );
+        new_overmap.invalidate_horde_index();
     }
 }
 
@@ -169,6 +222,7 @@ void overmapbuffer::fix_nemesis( overmap &new_overmap )
         overmap &om = get( omp );
         om.spawn_mon_group( mg, 1 );
         new_overmap.zg.erase( it++ );
+        new_overmap.invalidate_horde_index();
         //there should only be one nemesis, so we can break after finding it
         break;
     }
@@ -236,6 +290,7 @@ void overmapbuffer::clear()
     overmaps.clear();
     known_non_existing.clear();
     placed_unique_specials.clear();
+    travel_paths.clear();
     last_requested_overmap = nullptr;
 }
 
@@ -918,24 +973,111 @@ static bool is_ramp( const tripoint_abs_omt &omt_pos )
            ( oter->get_type_id() == oter_type_bridgehead_ramp );
 }
 
-std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
-    const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
+static pf::omt_scoring_fn travel_path_scorer( const tripoint_abs_omt &src,
+        const overmap_path_params &params )
 {
-    if( src == overmap::invalid_tripoint || dest == overmap::invalid_tripoint ) {
-        return {};
-    }
-
-    const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
+    return [src, &params]( tripoint_abs_omt pos ) {
         const int cur_cost = pos == src ? 0 : get_terrain_cost( pos, params );
         if( cur_cost < 0 ) {
             return pf::omt_score::rejected;
         }
         return pf::omt_score( cur_cost, is_ramp( pos ) );
     };
+}
+
+// About one for each travelling NPC
+static constexpr size_t max_cached_travel_paths = 64;
+// More detours than this and the path is found again from scratch
+static constexpr int max_travel_path_repairs = 4;
+
+/**
+ * Replaces the stretches of the path (dest first) that can't be travelled anymore by detours.
+ * Returns false if a stretch couldn't be repaired.
+ */
+static bool repair_travel_path( std::vector<tripoint_abs_omt> &path,
+                                const overmap_path_params &params )
+{
+    // Can path[i] still be entered from path[i + 1]
+    const auto passable = [&]( size_t i ) {
+        if( get_terrain_cost( path[i], params ) < 0 ) {
+            return false;
+        }
+        return path[i].z() == path[i + 1].z() || is_ramp( path[i + 1] );
+    };
+    int repairs = 0;
+    for( size_t i = path.size() - 1; i-- > 0; ) {
+        if( passable( i ) ) {
+            continue;
+        }
+        if( ++repairs > max_travel_path_repairs ) {
+            return false;
+        }
+        // The first point past the blocked stretch, the detour goes there from the point before it
+        size_t rejoin = i;
+        while( rejoin > 0 && get_terrain_cost( path[rejoin], params ) < 0 ) {
+            rejoin--;
+        }
+        const tripoint_abs_omt from = path[i + 1];
+        const int radius = std::max( 8, 2 * rl_dist( from, path[rejoin] ) );
+        const pf::simple_path<tripoint_abs_omt> detour = pf::find_overmap_path( from, path[rejoin],
+                radius, travel_path_scorer( from, params ), g->display_om_pathfinding_progress );
+        if( detour.points.empty() ) {
+            return false;
+        }
+        path.erase( path.begin() + rejoin, path.begin() + i + 2 );
+        path.insert( path.begin() + rejoin, detour.points.begin(), detour.points.end() );
+        i = rejoin;
+    }
+    return true;
+}
+
+std::vector<tripoint_abs_omt> overmapbuffer::cached_travel_path_from( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, const overmap_path_params &params )
+{
+    for( auto it = travel_paths.rbegin(); it != travel_paths.rend(); ++it ) {
+        if( it->dest != dest || !( it->params == params ) ) {
+            continue;
+        }
+        const auto on_path = std::find( it->points.begin(), it->points.end(), src );
+        if( on_path == it->points.end() ) {
+            continue;
+        }
+        std::vector<tripoint_abs_omt> path( it->points.begin(), std::next( on_path ) );
+        if( !repair_travel_path( path, params ) ) {
+            travel_paths.erase( std::next( it ).base() );
+            return {};
+        }
+        // Keep the rest of the path, it's what later calls start from
+        cached_travel_path used = std::move( *it );
+        travel_paths.erase( std::next( it ).base() );
+        used.points = path;
+        travel_paths.emplace_back( std::move( used ) );
+        return path;
+    }
+    return {};
+}
+
+std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
+    const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params )
+{
+    if( src == overmap::invalid_tripoint || dest == overmap::invalid_tripoint ) {
+        return {};
+    }
+
+    std::vector<tripoint_abs_omt> cached = cached_travel_path_from( src, dest, params );
+    if( !cached.empty() ) {
+        return cached;
+    }
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
-    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate,
-            g->display_om_pathfinding_progress );
+    const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius,
+            travel_path_scorer( src, params ), g->display_om_pathfinding_progress );
+    if( !path.points.empty() ) {
+        if( travel_paths.size() >= max_cached_travel_paths ) {
+            travel_paths.erase( travel_paths.begin() );
+        }
+        travel_paths.push_back( cached_travel_path{ dest, params, path.points } );
+    }
     return path.points;
 }
 
@@ -1150,26 +1292,97 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
 
-    std::vector<tripoint_abs_omt> result;
-    int found_dist = std::numeric_limits<int>::max();
-
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist < dist_xy ) {
-            break;
+    std::unordered_map<oter_id, bool> matching;
+    const auto matches = [&]( const oter_id & oter ) {
+        auto it = matching.find( oter );
+        if( it == matching.end() ) {
+            const bool match = std::any_of( params.types.begin(), params.types.end(),
+            [&]( const std::pair<std::string, ot_match_type> &type ) {
+                return is_ot_match( type.first, oter, type.second );
+            } );
+            it = matching.emplace( oter, match ).first;
         }
+        return it->second;
+    };
+    // Nearest and farthest distance from the origin to a square area
+    const auto dist_range = [&]( const point_abs_omt & corner, int size ) {
+        const point near = ( corner - origin.xy() ).raw();
+        const point far = near + point( size - 1, size - 1 );
+        const int dx = std::max( { 0, near.x, -far.x } );
+        const int dy = std::max( { 0, near.y, -far.y } );
+        const int far_dx = std::max( std::abs( near.x ), std::abs( far.x ) );
+        const int far_dy = std::max( std::abs( near.y ), std::abs( far.y ) );
+        return std::make_pair( std::max( dx, dy ), std::max( far_dx, far_dy ) );
+    };
 
-        for( int z = params.min_z; z <= params.max_z; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
-            const int dist = square_dist( origin, loc );
-
-            if( found_dist < dist ) {
-                continue;
+    // Best first over the overmaps in range and the chunks of them that have a matching
+    // terrain, so only the chunks that may be closer than what was found get scanned.
+    // Overmaps are only created once the search gets to them.
+    struct search_area {
+        point_abs_om om;
+        std::optional<tripoint_om_omt> chunk;
+    };
+    std::vector<search_area> areas;
+    std::priority_queue<std::pair<int, size_t>, std::vector<std::pair<int, size_t>>, std::greater<>>
+            open_areas;
+    const point_rel_omt search_radius( max_dist, max_dist );
+    const point_abs_om om_min = project_to<coords::om>( origin.xy() - search_radius );
+    const point_abs_om om_max = project_to<coords::om>( origin.xy() + search_radius );
+    for( int x = om_min.x(); x <= om_max.x(); x++ ) {
+        for( int y = om_min.y(); y <= om_max.y(); y++ ) {
+            const point_abs_om om( x, y );
+            const std::pair<int, int> range = dist_range( project_to<coords::omt>( om ), OMAPX );
+            if( range.first <= max_dist && range.second >= min_dist ) {
+                open_areas.emplace( range.first, areas.size() );
+                areas.push_back( search_area{ om, std::nullopt } );
             }
+        }
+    }
 
-            if( is_findable_location( loc, params ) ) {
-                found_dist = dist;
+    std::vector<tripoint_abs_omt> result;
+    int found_dist = std::numeric_limits<int>::max();
+    while( !open_areas.empty() && open_areas.top().first <= found_dist ) {
+        const search_area area = areas[open_areas.top().second];
+        open_areas.pop();
+        overmap *om = params.existing_only ? get_existing( area.om ) : &get( area.om );
+        if( om == nullptr ) {
+            continue;
+        }
+        if( !area.chunk ) {
+            const point_abs_omt om_corner = project_to<coords::omt>( area.om );
+            for( const auto &terrain : om->terrain_chunks() ) {
+                if( !matches( terrain.first ) ) {
+                    continue;
+                }
+                for( const tripoint_om_omt &chunk : terrain.second ) {
+                    if( chunk.z() < params.min_z || chunk.z() > params.max_z ) {
+                        continue;
+                    }
+                    const point_abs_omt corner = om_corner + point_rel_omt( chunk.xy().raw() );
+                    const std::pair<int, int> range = dist_range( corner, overmap::terrain_chunk_size );
+                    if( range.first <= max_dist && range.second >= min_dist ) {
+                        open_areas.emplace( range.first, areas.size() );
+                        areas.push_back( search_area{ area.om, chunk } );
+                    }
+                }
+            }
+            continue;
+        }
+        for( int x = 0; x < overmap::terrain_chunk_size; x++ ) {
+            for( int y = 0; y < overmap::terrain_chunk_size; y++ ) {
+                const tripoint_om_omt local( area.chunk->x() + x, area.chunk->y() + y,
+                                             area.chunk->z() );
+                const tripoint_abs_omt loc = project_combine( area.om, local );
+                const int dist_xy = square_dist( origin.xy(), loc.xy() );
+                const int dist = square_dist( origin, loc );
+                if( dist_xy < min_dist || dist_xy > max_dist || dist > found_dist ||
+                    !matches( om->ter_unsafe( local ) ) || !is_findable_location( loc, params ) ) {
+                    continue;
+                }
+                if( dist < found_dist ) {
+                    found_dist = dist;
+                    result.clear();
+                }
                 result.push_back( loc );
             }
         }
@@ -49,6 +49,10 @@ struct overmap_path_params {
         auto it = travel_cost_per_type.find( type );
         return it != travel_cost_per_type.end() ? it->second : -1;
     }
+    bool operator==( const overmap_path_params &rhs ) const {
+        return travel_cost_per_type == rhs.travel_cost_per_type && avoid_danger == rhs.avoid_danger &&
+               only_known_by_player == rhs.only_known_by_player;
+    }
     static constexpr int standard_cost = 10;
     static overmap_path_params for_player();
     static overmap_path_params for_npc();
@@ -152,8 +156,20 @@ class overmapbuffer
         /**
          * Uses overmap coordinates, that means x and y are directly
          * compared with the position of the overmap.
+         * New overmaps are generated from a random stream seeded by the world seed and
+         * their position, so they don't depend on when they are first needed.
          */
         overmap &get( const point_abs_om & );
+        /**
+         * Loads or creates one of the overmaps around the one containing p, if p is close
+         * enough to it that it will be needed soon.  Called while the game waits for input, so
+         * crossing into the next overmap doesn't stall on generating it.  The generation still
+         * runs on the main thread, so an input that arrives meanwhile waits for it instead.
+         * The result is the same as generating it on demand, so how long the player idles
+         * doesn't change the game.
+         * @returns whether an overmap was loaded or created.
+         */
+        bool generate_ahead( const tripoint_abs_omt &p );
         void save();
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
@@ -348,6 +364,11 @@ class overmapbuffer
         bool reveal( const tripoint_abs_omt &center, int radius );
         bool reveal( const tripoint_abs_omt &center, int radius,
                      const std::function<bool( const oter_id & )> &filter );
+        /**
+         * Path from src to dest, with dest first and src last.  Paths are remembered, so asking
+         * again from a point along an earlier path to the same destination only checks that the
+         * rest of it is still passable, and goes around the parts that aren't.
+         */
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, const overmap_path_params &params );
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
@@ -543,6 +564,21 @@ class overmapbuffer
         // Set of globally unique overmap specials that have already been placed
         std::unordered_set<overmap_special_id> placed_unique_specials;
 
+        struct cached_travel_path {
+            tripoint_abs_omt dest;
+            overmap_path_params params;
+            /** Like the result of @ref get_travel_path, dest first */
+            std::vector<tripoint_abs_omt> points;
+        };
+        /** Recently found travel paths, most recently used last */
+        std::vector<cached_travel_path> travel_paths;
+        /**
+         * The part of a cached path from src to dest, with the stretches that became impassable
+         * replaced by a new path around them.  Empty if there is none or it can't be repaired.
+         */
+        std::vector<tripoint_abs_omt> cached_travel_path_from( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, const overmap_path_params &params );
+
         /**
          * Get a list of notes in the (loaded) overmaps.
          * @param z only this specific z-level is search for notes.
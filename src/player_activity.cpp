@@ -17,6 +17,7 @@
 #include "item.h"
 #include "itype.h"
 #include "map.h"
+#include "profiler.h"
 #include "rng.h"
 #include "skill.h"
 #include "sounds.h"
@@ -223,6 +224,7 @@ void player_activity::start_or_resume( Character &who, bool resuming )
 
 void player_activity::do_turn( Character &you )
 {
+    profiler::scope prof( profiler::category::activity, type );
     // Specifically call the do turn function for the cancellation activity early
     // This is because the game can get stuck trying to fuel a fire when it's not...
     if( type == ACT_MIGRATION_CANCEL ) {
@@ -0,0 +1,420 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <new>
+#include <ostream>
+#include <vector>
+
+#include "cata_utility.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "json.h"
+#include "string_formatter.h"
+
+#if defined(CATA_PROFILE_ALLOCATIONS)
+// Counts allocations for the turn profiler; the remaining forms of new and delete end up here
+static std::atomic<int64_t> allocations( 0 );
+
+void *operator new( std::size_t size )
+{
+    allocations.fetch_add( 1, std::memory_order_relaxed );
+    if( size == 0 ) {
+        size = 1;
+    }
+    while( true ) {
+        if( void *ptr = std::malloc( size ) ) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if( handler == nullptr ) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *operator new[]( std::size_t size )
+{
+    return ::operator new( size );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete[]( void *ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+#endif
+
+namespace profiler
+{
+
+bool counting = false;
+
+namespace
+{
+
+struct trace_event {
+    category cat;
+    std::string id;
+    clock::time_point start;
+    clock::duration duration;
+};
+
+// Keeps the newest events once it is full, about 20MB worth of trace
+constexpr size_t max_trace_events = 200000;
+
+struct profiler_state {
+    std::array<counter_map, static_cast<size_t>( category::last )> counters;
+    // counters that ran during the current turn
+    std::vector<counter *> touched;
+    bool trace = false;
+    std::deque<trace_event> events;
+    clock::time_point epoch = clock::now();
+
+    turn_sample this_turn;
+    std::deque<turn_sample> turns;
+};
+
+profiler_state &state()
+{
+    static profiler_state instance;
+    return instance;
+}
+
+int histogram_bucket( clock::duration time )
+{
+    const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>( time ).count();
+    if( us < 1 ) {
+        return 0;
+    }
+    return std::min( histogram_buckets - 1, 1 + static_cast<int>( std::log2( us ) ) );
+}
+
+double to_us( clock::duration time )
+{
+    return std::chrono::duration<double, std::micro>( time ).count();
+}
+
+} // namespace
+
+void set_enabled( bool enable, bool trace )
+{
+    counting = enable;
+    state().trace = enable && trace;
+    if( enable && state().events.empty() ) {
+        state().epoch = clock::now();
+    }
+}
+
+bool tracing()
+{
+    return state().trace;
+}
+
+void reset()
+{
+    profiler_state &s = state();
+    for( counter_map &counters : s.counters ) {
+        counters.clear();
+    }
+    s.touched.clear();
+    s.events.clear();
+    s.epoch = clock::now();
+    s.this_turn = turn_sample();
+    s.turns.clear();
+}
+
+static void append_slow_turn( const turn_sample &sample )
+{
+    const std::string path = "slow_turns.csv";
+    const bool new_file = !file_exist( path );
+    std::ofstream fout( fs::u8path( path ), std::ios::out | std::ios::app );
+    if( !fout ) {
+        DebugLog( D_WARNING, D_MAIN ) << "Could not write " << path;
+        return;
+    }
+    write_turn_csv( fout, { sample }, new_file );
+}
+
+void end_turn( int turn )
+{
+    profiler_state &s = state();
+    for( counter *c : s.touched ) {
+        c->turn_histogram[histogram_bucket( c->this_turn )]++;
+        c->this_turn = clock::duration::zero();
+    }
+    s.touched.clear();
+
+    if( !timing_turns() ) {
+        return;
+    }
+    s.this_turn.turn = turn;
+    if( turn_time_budget > 0 && s.this_turn.total() > std::chrono::milliseconds( turn_time_budget ) ) {
+        append_slow_turn( s.this_turn );
+    }
+    if( s.turns.size() >= turn_window_size ) {
+        s.turns.pop_front();
+    }
+    s.turns.push_back( s.this_turn );
+    s.this_turn = turn_sample();
+}
+
+std::string turn_phase_name( turn_phase phase )
+{
+    switch( phase ) {
+        // *INDENT-OFF*
+        case turn_phase::timed_events: return "timed_events";
+        case turn_phase::hordes: return "hordes";
+        case turn_phase::player_body: return "player_body";
+        case turn_phase::autosave: return "autosave";
+        case turn_phase::weather: return "weather";
+        case turn_phase::npc_spawn: return "npc_spawn";
+        case turn_phase::player_activity: return "player_activity";
+        case turn_phase::sound_markers: return "sound_markers";
+        case turn_phase::scent: return "scent";
+        case turn_phase::floor_caches: return "floor_caches";
+        case turn_phase::vehicles: return "vehicles";
+        case turn_phase::fields: return "fields";
+        case turn_phase::items: return "items";
+        case turn_phase::explosions: return "explosions";
+        case turn_phase::sounds: return "sounds";
+        case turn_phase::map_cache: return "map_cache";
+        case turn_phase::monsters: return "monsters";
+        case turn_phase::npc_overmap: return "npc_overmap";
+        case turn_phase::emissions: return "emissions";
+        case turn_phase::player_turn: return "player_turn";
+        case turn_phase::redraw: return "redraw";
+        case turn_phase::body_temperature: return "body_temperature";
+        case turn_phase::morale: return "morale";
+        case turn_phase::sfx: return "sfx";
+        case turn_phase::last: break;
+        // *INDENT-ON*
+    }
+    return "unknown";
+}
+
+clock::duration turn_sample::total() const
+{
+    clock::duration ret = clock::duration::zero();
+    for( const phase_sample &phase : phases ) {
+        ret += phase.time;
+    }
+    return ret;
+}
+
+int64_t allocation_count()
+{
+#if defined(CATA_PROFILE_ALLOCATIONS)
+    return allocations.load( std::memory_order_relaxed );
+#else
+    return 0;
+#endif
+}
+
+const std::deque<turn_sample> &turn_window()
+{
+    return state().turns;
+}
+
+void write_turn_csv( std::ostream &fout, const std::deque<turn_sample> &turns, bool header )
+{
+    if( header ) {
+        fout << "turn,total_us";
+        for( int i = 0; i < static_cast<int>( turn_phase::last ); i++ ) {
+            const std::string name = turn_phase_name( static_cast<turn_phase>( i ) );
+            fout << "," << name << "_us," << name << "_allocs";
+        }
+        fout << "\n";
+    }
+    for( const turn_sample &sample : turns ) {
+        fout << sample.turn << "," << static_cast<int64_t>( to_us( sample.total() ) );
+        for( const phase_sample &phase : sample.phases ) {
+            fout << "," << static_cast<int64_t>( to_us( phase.time ) ) << "," << phase.allocations;
+        }
+        fout << "\n";
+    }
+}
+
+std::string turn_summary()
+{
+    const std::deque<turn_sample> &turns = turn_window();
+    // NOLINTNEXTLINE(cata-translate-string-literal)
+    std::string ret = string_format( "%d turns\n%-20s %10s %10s %12s\n",
+                                     static_cast<int>( turns.size() ), "phase",
+                                     "avg us", "max us", "avg allocs" );
+    if( turns.empty() ) {
+        return ret;
+    }
+    for( int i = 0; i < static_cast<int>( turn_phase::last ); i++ ) {
+        clock::duration total = clock::duration::zero();
+        clock::duration max = clock::duration::zero();
+        int64_t allocs = 0;
+        for( const turn_sample &sample : turns ) {
+            const phase_sample &phase = sample.phases[i];
+            total += phase.time;
+            max = std::max( max, phase.time );
+            allocs += phase.allocations;
+        }
+        // NOLINTNEXTLINE(cata-translate-string-literal)
+        ret += string_format( "%-20s %10.1f %10.1f %12.1f\n", turn_phase_name( static_cast<turn_phase>( i ) ),
+                              to_us( total ) / turns.size(), to_us( max ),
+                              static_cast<double>( allocs ) / turns.size() );
+    }
+    return ret;
+}
+
+bool write_turn_window_csv( const std::string &path )
+{
+    return write_to_file( path, []( std::ostream & fout ) {
+        write_turn_csv( fout, turn_window() );
+    }, "turn profile" );
+}
+
+#if !defined(CATA_NO_PROFILER)
+turn_phase_scope::turn_phase_scope( turn_phase phase )
+{
+    if( timing_turns() ) {
+        phase_ = phase;
+        allocations_ = allocation_count();
+        start_ = clock::now();
+    }
+}
+
+turn_phase_scope::~turn_phase_scope()
+{
+    if( phase_ != turn_phase::last ) {
+        phase_sample &sample = state().this_turn.phases[static_cast<size_t>( phase_ )];
+        sample.time += clock::now() - start_;
+        sample.allocations += allocation_count() - allocations_;
+    }
+}
+#endif
+
+void record( category cat, const std::string &id, clock::time_point start, clock::time_point end )
+{
+    profiler_state &s = state();
+    const clock::duration time = end - start;
+    counter &c = s.counters[static_cast<size_t>( cat )][id];
+    if( c.this_turn == clock::duration::zero() ) {
+        s.touched.push_back( &c );
+    }
+    c.calls++;
+    c.total += time;
+    c.max = std::max( c.max, time );
+    // never zero, so the counter isn't added to `touched` twice
+    c.this_turn += std::max( time, clock::duration( 1 ) );
+    if( s.trace ) {
+        if( s.events.size() >= max_trace_events ) {
+            s.events.pop_front();
+        }
+        s.events.push_back( trace_event{ cat, id, start, time } );
+    }
+}
+
+const counter_map &get_counters( category cat )
+{
+    return state().counters[static_cast<size_t>( cat )];
+}
+
+std::string category_name( category cat )
+{
+    switch( cat ) {
+        case category::eoc:
+            return "effect_on_condition";
+        case category::activity:
+            return "activity";
+        case category::monster_special:
+            return "monster_special";
+        case category::field:
+            return "field";
+        case category::active_item:
+            return "active_item";
+        case category::last:
+            break;
+    }
+    return "unknown";
+}
+
+std::string summary( int max_lines )
+{
+    struct line {
+        category cat;
+        const std::string *id;
+        const counter *c;
+    };
+    std::vector<line> lines;
+    for( int i = 0; i < static_cast<int>( category::last ); i++ ) {
+        const category cat = static_cast<category>( i );
+        for( const std::pair<const std::string, counter> &entry : get_counters( cat ) ) {
+            lines.push_back( line{ cat, &entry.first, &entry.second } );
+        }
+    }
+    std::sort( lines.begin(), lines.end(), []( const line & lhs, const line & rhs ) {
+        return lhs.c->total > rhs.c->total;
+    } );
+    if( static_cast<int>( lines.size() ) > max_lines ) {
+        lines.resize( max_lines );
+    }
+
+    // NOLINTNEXTLINE(cata-translate-string-literal)
+    std::string ret = string_format( "%-20s %-32s %10s %10s %10s %10s\n", "category", "id", "calls",
+                                     "total ms", "avg us", "max us" );
+    for( const line &l : lines ) {
+        // NOLINTNEXTLINE(cata-translate-string-literal)
+        ret += string_format( "%-20s %-32s %10d %10.2f %10.2f %10.2f\n", category_name( l.cat ), *l.id,
+                              l.c->calls, to_us( l.c->total ) / 1000.0,
+                              to_us( l.c->total ) / std::max<int64_t>( l.c->calls, 1 ), to_us( l.c->max ) );
+    }
+    return ret;
+}
+
+void write_chrome_trace( std::ostream &fout )
+{
+    const profiler_state &s = state();
+    JsonOut jsout( fout );
+    jsout.start_object();
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    for( const trace_event &ev : s.events ) {
+        jsout.start_object();
+        jsout.member( "name", ev.id );
+        jsout.member( "cat", category_name( ev.cat ) );
+        jsout.member( "ph", "X" );
+        jsout.member( "ts", to_us( ev.start - s.epoch ) );
+        jsout.member( "dur", to_us( ev.duration ) );
+        jsout.member( "pid", 0 );
+        jsout.member( "tid", 0 );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.end_object();
+}
+
+bool write_chrome_trace( const std::string &path )
+{
+    return write_to_file( path, []( std::ostream & fout ) {
+        write_chrome_trace( fout );
+    }, "profiler trace" );
+}
+
+} // namespace profiler
@@ -0,0 +1,249 @@
+#pragma once
+#ifndef CATA_SRC_PROFILER_H
+#define CATA_SRC_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "cached_options.h"
+#include "int_id.h"
+#include "string_id.h"
+
+/**
+ * Counters for the hot paths of a turn, keyed by what is being run: the id of an
+ * effect_on_condition, activity, monster special attack, field type or active item.
+ *
+ * A profiler::scope times the code between its construction and destruction.  Counting is
+ * off until it is turned on from the debug menu, and while it is off a scope costs a single
+ * branch.  Building with CATA_NO_PROFILER defined (`make PROFILER=0`, or `-DPROFILER=OFF`
+ * with CMake) removes the scopes altogether.
+ *
+ * do_turn is also split into phases by profiler::turn_phase_scope.  The wall time and number of
+ * allocations of each phase are kept for the last turns, and turns that take longer than the
+ * "Turn time budget" option are appended to slow_turns.csv.  Allocations are only counted in
+ * builds with CATA_PROFILE_ALLOCATIONS defined (`make PROFILE_ALLOCATIONS=1`, or
+ * `-DPROFILE_ALLOCATIONS=ON` with CMake), which replace the global operator new; otherwise
+ * they are always 0.
+ */
+namespace profiler
+{
+
+enum class category : int {
+    eoc,
+    activity,
+    monster_special,
+    field,
+    active_item,
+    last
+};
+
+using clock = std::chrono::steady_clock;
+
+// Per turn totals are bucketed by log2 of their microseconds, the last bucket takes everything above
+constexpr int histogram_buckets = 16;
+
+struct counter {
+    int64_t calls = 0;
+    clock::duration total = clock::duration::zero();
+    clock::duration max = clock::duration::zero();
+    /** How many turns the total for the turn fell into each bucket */
+    std::array<int, histogram_buckets> turn_histogram = {};
+    clock::duration this_turn = clock::duration::zero();
+};
+
+using counter_map = std::unordered_map<std::string, counter>;
+
+/** Whether scopes are counted; only changed via @ref set_enabled */
+extern bool counting;
+
+/** @param trace also keep every timed scope, to be written out by @ref write_chrome_trace */
+void set_enabled( bool enable, bool trace );
+bool tracing();
+/** Forget all counters and trace events */
+void reset();
+/**
+ * Closes the per turn totals of everything that ran this turn and the sample of the turn
+ * phases, called once at the end of each turn.
+ */
+void end_turn( int turn );
+
+void record( category cat, const std::string &id, clock::time_point start, clock::time_point end );
+
+const counter_map &get_counters( category cat );
+std::string category_name( category cat );
+
+/** Table of the most expensive ids over all categories */
+std::string summary( int max_lines );
+/**
+ * Writes the recorded trace in the Chrome trace event format, for chrome://tracing or
+ * https://ui.perfetto.dev.  Returns false if writing failed.
+ */
+bool write_chrome_trace( const std::string &path );
+void write_chrome_trace( std::ostream &fout );
+
+enum class turn_phase : int {
+    timed_events,
+    hordes,
+    player_body,
+    autosave,
+    weather,
+    npc_spawn,
+    player_activity,
+    sound_markers,
+    scent,
+    floor_caches,
+    vehicles,
+    fields,
+    items,
+    explosions,
+    sounds,
+    map_cache,
+    monsters,
+    npc_overmap,
+    emissions,
+    player_turn,
+    redraw,
+    body_temperature,
+    morale,
+    sfx,
+    last
+};
+
+std::string turn_phase_name( turn_phase phase );
+
+struct phase_sample {
+    clock::duration time = clock::duration::zero();
+    int64_t allocations = 0;
+};
+
+struct turn_sample {
+    int turn = 0;
+    std::array<phase_sample, static_cast<size_t>( turn_phase::last )> phases;
+
+    /** Time spent in all phases, which leaves out waiting for player input */
+    clock::duration total() const;
+};
+
+/** Number of turns kept in @ref turn_window */
+constexpr size_t turn_window_size = 600;
+
+/** Whether the phases of the turn are being timed */
+inline bool timing_turns()
+{
+    return counting || turn_time_budget > 0;
+}
+/** Whether allocations are counted, see the top of this file */
+#if defined(CATA_PROFILE_ALLOCATIONS)
+constexpr bool counts_allocations = true;
+#else
+constexpr bool counts_allocations = false;
+#endif
+/** Allocations made through the global operator new so far, 0 if they aren't counted */
+int64_t allocation_count();
+/** The last @ref turn_window_size turns, oldest first */
+const std::deque<turn_sample> &turn_window();
+/** Writes the turn window as CSV, a row per turn and a time and allocation column per phase */
+void write_turn_csv( std::ostream &fout, const std::deque<turn_sample> &turns, bool header = true );
+bool write_turn_window_csv( const std::string &path );
+/** Average and slowest time and allocations of each phase over the turn window */
+std::string turn_summary();
+
+class turn_phase_scope
+{
+    public:
+#if defined(CATA_NO_PROFILER)
+        explicit turn_phase_scope( turn_phase ) {}
+#else
+        explicit turn_phase_scope( turn_phase phase );
+        ~turn_phase_scope();
+#endif
+        turn_phase_scope( const turn_phase_scope & ) = delete;
+        turn_phase_scope &operator=( const turn_phase_scope & ) = delete;
+
+#if !defined(CATA_NO_PROFILER)
+    private:
+        turn_phase phase_ = turn_phase::last;
+        clock::time_point start_;
+        int64_t allocations_ = 0;
+#endif
+};
+
+/**
+ * Times the code from its construction to its destruction, under @p id.  The id isn't copied:
+ * a std::string has to outlive the scope, and string ids are interned, so their strings always
+ * do.  Ids that take some work to get, like the string id of an int_id or the type of an item,
+ * are only looked up while counting.
+ */
+class scope
+{
+    public:
+#if defined(CATA_NO_PROFILER)
+        scope( category, const std::string & ) {}
+        template<typename Id>
+        scope( category, const Id & ) {}
+#else
+        scope( category cat, const std::string &id ) {
+            if( counting ) {
+                start( cat, id );
+            }
+        }
+        template<typename T>
+        scope( category cat, const string_id<T> &id ) {
+            static_assert( !string_id_params<T>::dynamic, "only interned strings outlive the scope" );
+            if( counting ) {
+                start( cat, id.str() );
+            }
+        }
+        template<typename T>
+        scope( category cat, const int_id<T> &id ) {
+            if( counting ) {
+                start( cat, id.id().str() );
+            }
+        }
+        /** @p get_id returns a string id, it is only called while counting */
+        template<typename GetId, typename = std::enable_if_t<std::is_invocable_v<GetId>>>
+        scope( category cat, GetId &&get_id ) {
+            if( counting ) {
+                const auto &id = get_id();
+                static_assert( !string_id_params<typename std::decay_t<decltype( id )>::value_type>::dynamic,
+                               "only interned strings outlive the scope" );
+                start( cat, id.str() );
+            }
+        }
+
+        ~scope() {
+            if( id_ != nullptr ) {
+                record( cat_, *id_, start_, clock::now() );
+            }
+        }
+#endif
+        // the id would be gone before the scope records it
+        scope( category, std::string && ) = delete;
+        scope( const scope & ) = delete;
+        scope &operator=( const scope & ) = delete;
+
+#if !defined(CATA_NO_PROFILER)
+    private:
+        void start( category cat, const std::string &id ) {
+            cat_ = cat;
+            id_ = &id;
+            start_ = clock::now();
+        }
+
+        category cat_ = category::last;
+        // null unless counting
+        const std::string *id_ = nullptr;
+        clock::time_point start_;
+#endif
+};
+
+} // namespace profiler
+
+#endif // CATA_SRC_PROFILER_H
@@ -104,6 +104,11 @@ void quality::load_static( const JsonObject &jo, const std::string &src )
     quality_factory.load( jo, src );
 }
 
+const std::vector<quality> &quality::get_all()
+{
+    return quality_factory.get_all();
+}
+
 void quality::load( const JsonObject &jo, const std::string_view )
 {
     mandatory( jo, was_loaded, "name", name );
@@ -135,16 +135,14 @@ void game::serialize( std::ostream &fout )
                  inactive_global_effect_on_condition_vector );
 
     //save queued effect_on_conditions
-    queued_eocs temp_queued( queued_global_effect_on_conditions );
     json.member( "queued_global_effect_on_conditions" );
     json.start_array();
-    while( !temp_queued.empty() ) {
+    for( const queued_eoc *queued : queued_global_effect_on_conditions.sorted() ) {
         json.start_object();
-        json.member( "time", temp_queued.top().time );
-        json.member( "eoc", temp_queued.top().eoc );
-        json.member( "context", temp_queued.top().context );
+        json.member( "time", queued->time );
+        json.member( "eoc", queued->eoc );
+        json.member( "context", queued->context );
         json.end_object();
-        temp_queued.pop();
     }
     json.end_array();
     global_variables_instance.serialize( json );
@@ -402,6 +400,7 @@ void overmap::unserialize( const cata_path &file_name, std::istream &fin )
 
 void overmap::unserialize( const JsonObject &jsobj )
 {
+    terrain_chunks_dirty = true;
     // These must be read in this order.
     if( jsobj.has_member( "mapgen_arg_storage" ) ) {
         jsobj.read( "mapgen_arg_storage", mapgen_arg_storage, true );
@@ -721,6 +720,7 @@ void overmap::unserialize( const JsonObject &jsobj )
 // throws std::exception
 void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_path )
 {
+    terrain_chunks_dirty = true;
     JsonArray ja = jsin.get_array();
     JsonObject jo = ja.next_object();
 
@@ -1476,13 +1476,7 @@ void global_variables::unserialize( JsonObject &jo )
 {
     jo.read( "global_vals", global_values );
     // potentially migrate some variable names
-    for( std::pair<std::string, std::string> migration : migrations ) {
-        if( global_values.count( migration.first ) != 0 ) {
-            auto extracted = global_values.extract( migration.first );
-            extracted.key() = migration.second;
-            global_values.insert( std::move( extracted ) );
-        }
-    }
+    global_values.migrate( migrations );
 }
 
 void timed_event_manager::unserialize_all( const JsonArray &ja )
@@ -72,6 +72,7 @@
 #include "flat_set.h"
 #include "game.h"
 #include "game_constants.h"
+#include "global_vars.h"
 #include "inventory.h"
 #include "item.h"
 #include "item_contents.h"
@@ -1507,16 +1508,14 @@ void Character::store( JsonOut &json ) const
     json.member( "suppress_autohaul", suppress_autohaul );
 
     //save queued effect_on_conditions
-    queued_eocs temp_queued( queued_effect_on_conditions );
     json.member( "queued_effect_on_conditions" );
     json.start_array();
-    while( !temp_queued.empty() ) {
+    for( const queued_eoc *queued : queued_effect_on_conditions.sorted() ) {
         json.start_object();
-        json.member( "time", temp_queued.top().time );
-        json.member( "eoc", temp_queued.top().eoc );
-        json.member( "context", temp_queued.top().context );
+        json.member( "time", queued->time );
+        json.member( "eoc", queued->eoc );
+        json.member( "context", queued->context );
         json.end_object();
-        temp_queued.pop();
     }
 
     json.end_array();
@@ -3001,7 +3000,7 @@ void item::io( Archive &archive )
 
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
-    if( get_chapters() == 0 ) {
+    if( get_chapters() == 0 && !item_vars.empty() ) {
         for( auto it = item_vars.begin(); it != item_vars.end(); ) {
             if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
                 item_vars.erase( it++ );
@@ -3809,13 +3808,7 @@ void Creature::load( const JsonObject &jsin )
 
     jsin.read( "values", values );
     // potentially migrate some values
-    for( std::pair<std::string, std::string> migration : get_globals().migrations ) {
-        if( values.count( migration.first ) != 0 ) {
-            auto extracted = values.extract( migration.first );
-            extracted.key() = migration.second;
-            values.insert( std::move( extracted ) );
-        }
-    }
+    values->migrate( get_globals().migrations );
 
     jsin.read( "damage_over_time_map", damage_over_time_map );
 
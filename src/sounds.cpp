@@ -7,6 +7,7 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "activity_type.h"
 #include "cached_options.h" // IWYU pragma: keep
@@ -21,6 +22,8 @@
 #include "game.h"
 #include "game_constants.h"
 #include "itype.h" // IWYU pragma: keep
+#include "level_cache.h"
+#include "lightmap.h"
 #include "line.h"
 #include "make_static.h"
 #include "map.h"
@@ -29,6 +32,7 @@
 #include "monster.h"
 #include "music.h"
 #include "npc.h"
+#include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "player_activity.h"
@@ -269,6 +273,95 @@ static int sound_distance( const tripoint &source, const tripoint &sink )
     return rl_dist( source.xy(), sink.xy() ) + vertical_attenuation;
 }
 
+namespace
+{
+
+// How much farther a sound seems for each opaque tile it has to pass through
+constexpr int sound_occlusion_penalty = 10;
+
+/**
+ * How far a sound is from each tile of the reality bubble, in the units of sound_distance.
+ * Without occlusion that's sound_distance itself.  With occlusion the sound floods out from its
+ * source on the source's z-level, going around walls and closed doors or through them at
+ * sound_occlusion_penalty tiles each, and the vertical part of sound_distance is added on top.
+ * Either way every listener looks up its distance in constant time.
+ */
+class sound_field
+{
+    public:
+        /** Tiles at max_dist or farther count as out of earshot and aren't flooded */
+        sound_field( const tripoint &source, int max_dist, bool occlusion );
+        int distance( const tripoint &p ) const;
+
+    private:
+        tripoint source;
+        int max_dist;
+        // Corner and size of the flooded area, the flood is empty without occlusion
+        point corner;
+        point size;
+        std::vector<int> flood;
+};
+
+sound_field::sound_field( const tripoint &source, int max_dist, bool occlusion )
+    : source( source ), max_dist( max_dist )
+{
+    map &here = get_map();
+    if( !occlusion || max_dist <= 0 || !here.inbounds( source ) ) {
+        return;
+    }
+    corner = point( std::max( 0, source.x - max_dist ), std::max( 0, source.y - max_dist ) );
+    size = point( std::min( MAPSIZE_X, source.x + max_dist + 1 ),
+                  std::min( MAPSIZE_Y, source.y + max_dist + 1 ) ) - corner;
+    flood.assign( static_cast<size_t>( size.x ) * size.y, max_dist );
+    const level_cache &cache = here.get_cache_ref( source.z );
+
+    // Dijkstra with a bucket of tiles for each distance, all steps cost at least one
+    std::vector<std::vector<point>> buckets( max_dist );
+    flood[( source.y - corner.y ) * size.x + source.x - corner.x] = 0;
+    buckets[0].push_back( source.xy() );
+    for( int dist = 0; dist < max_dist; dist++ ) {
+        for( const point &p : buckets[dist] ) {
+            if( flood[( p.y - corner.y ) * size.x + p.x - corner.x] < dist ) {
+                // Reached by a shorter way since it was queued
+                continue;
+            }
+            for( const tripoint &offset : eight_horizontal_neighbors ) {
+                const point next = p + offset.xy();
+                const point rel = next - corner;
+                if( rel.x < 0 || rel.y < 0 || rel.x >= size.x || rel.y >= size.y ) {
+                    continue;
+                }
+                const bool opaque = cache.transparency_cache[next.x][next.y] == LIGHT_TRANSPARENCY_SOLID;
+                const int next_dist = dist + ( opaque ? sound_occlusion_penalty : 1 );
+                int &known = flood[rel.y * size.x + rel.x];
+                if( next_dist < known ) {
+                    known = next_dist;
+                    if( next_dist < max_dist ) {
+                        buckets[next_dist].push_back( next );
+                    }
+                }
+            }
+        }
+        buckets[dist].clear();
+        buckets[dist].shrink_to_fit();
+    }
+}
+
+int sound_field::distance( const tripoint &p ) const
+{
+    if( flood.empty() ) {
+        return sound_distance( source, p );
+    }
+    const int vertical = sound_distance( source, tripoint( source.xy(), p.z ) );
+    const point rel = p.xy() - corner;
+    if( rel.x < 0 || rel.y < 0 || rel.x >= size.x || rel.y >= size.y ) {
+        return max_dist + vertical;
+    }
+    return flood[rel.y * size.x + rel.x] + vertical;
+}
+
+} // namespace
+
 static std::string season_str( const season_type &season )
 {
     switch( season ) {
@@ -473,6 +566,7 @@ void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
+    const bool occlusion = get_option<bool>( "SOUND_OCCLUSION" );
     for( const centroid &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -490,10 +584,15 @@ void sounds::process_sounds()
             const tripoint_abs_sm target( abs_sm, source.z );
             overmap_buffer.signal_hordes( target, sig_power );
         }
+        if( vol <= 0 ) {
+            continue;
+        }
+        // Nothing at twice the volume or farther can hear the sound
+        const sound_field field( source, vol * 2, occlusion );
         // Alert all monsters (that can hear) to the sound.
         for( monster &critter : g->all_monsters() ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = field.distance( critter.pos() );
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
                 critter.hear_sound( source, vol, dist, this_centroid.provocative );
@@ -502,7 +601,7 @@ void sounds::process_sounds()
         // Trigger sound-triggered traps and ensure they are still valid
         for( const trap *trapType : trap::get_sound_triggered_traps() ) {
             for( const tripoint &tp : get_map().trap_locations( trapType->id ) ) {
-                const int dist = sound_distance( source, tp );
+                const int dist = field.distance( tp );
                 const trap &tr = get_map().tr_at( tp );
                 // Exclude traps that certainly won't hear the sound
                 if( vol * 2 > dist ) {
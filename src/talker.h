@@ -4,6 +4,7 @@
 
 #include "coordinates.h"
 #include "effect.h"
+#include "global_vars.h"
 #include "item.h"
 #include "messages.h"
 #include "type_id.h"
@@ -354,6 +355,15 @@ class talker
         }
         virtual void set_value( const std::string &, const std::string & ) {}
         virtual void remove_value( const std::string & ) {}
+        // typed variable access for callers that interned the name beforehand.  Talkers that
+        // only store strings fall back to the string interface
+        virtual std::optional<var_value> maybe_get_var( const var_key &key ) const {
+            std::optional<std::string> val = maybe_get_value( key.str() );
+            return val ? std::optional<var_value>( var_value( *val ) ) : std::nullopt;
+        }
+        virtual void set_var( const var_key &key, const var_value &value ) {
+            set_value( key.str(), value.str() );
+        }
 
         // inventory, buying, and selling
         virtual bool is_wearing( const itype_id & ) const {
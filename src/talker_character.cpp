@@ -464,11 +464,22 @@ const
     return me_chr_const->maybe_get_value( var_name );
 }
 
+std::optional<var_value> talker_character_const::maybe_get_var( const var_key &key ) const
+{
+    const var_value *val = me_chr_const->get_var( key );
+    return val == nullptr ? std::nullopt : std::optional<var_value> { *val };
+}
+
 void talker_character::set_value( const std::string &var_name, const std::string &value )
 {
     me_chr->set_value( var_name, value );
 }
 
+void talker_character::set_var( const var_key &key, const var_value &value )
+{
+    me_chr->set_value( key, value );
+}
+
 void talker_character::remove_value( const std::string &var_name )
 {
     me_chr->remove_value( var_name );
@@ -3,6 +3,7 @@
 #define CATA_SRC_VALUE_PTR_H
 
 #include <memory>
+#include <type_traits>
 
 class JsonOut;
 class JsonValue;
@@ -66,22 +67,34 @@ bool value_ptr_equals( const value_ptr<T> &lhs, const value_ptr<T> &rhs )
  * it hides the fact it is a unique_ptr. It is intended for helping make types
  * noexcept movable by moving non-noexcept-movable types to the heap.
  *
- * Contractually speaking, should never be empty. However for performance reasons
- * in eg. item, moved-from heap<> objects do not automatically reset with a new
- * copy of the wrapped data.
+ * The wrapped value is only allocated once it is written to, until then (and after being
+ * moved from) it reads as a default constructed T.  Most items never get any flags, vars,
+ * faults, techniques or components of their own, so this keeps them from allocating an empty
+ * container for each.  Only const access and erasing by key avoid allocating; any non-const
+ * access, including begin(), end() and find(), allocates first, so that the iterators it
+ * returns always belong to this heap's own value.
  */
 template <class T>
 struct heap {
     private:
         std::unique_ptr<T> heaped_;
 
+        // What an unallocated heap reads as
+        static const T &empty_value() {
+            static const T empty{};
+            return empty;
+        }
+
     public:
-        template<typename ...Args>
+        heap() = default;
+
+        template < typename Arg, typename ...Args,
+                   std::enable_if_t < !std::is_same_v<std::decay_t<Arg>, heap> > * = nullptr >
         // NOLINTNEXTLINE(google-explicit-constructor)
-        heap( Args &&...args ) : heaped_{ new T{ std::forward<Args>( args )... } } {}
+        heap( Arg &&arg, Args &&...args ) :
+            heaped_{ new T{ std::forward<Arg>( arg ), std::forward<Args>( args )... } } {}
 
         // Unlike value_ptr, moves actually move and leave the moved-from heap empty.
-        // Using it again will cause a segfault without resetting it first.
         heap( heap && ) noexcept = default;
         heap &operator=( heap &&other ) noexcept = default;
 
@@ -90,11 +103,10 @@ struct heap {
             *this = rhs;
         }
         heap &operator=( heap const &rhs ) {
-            // This should always be true, however, sanity says do the right thing.
             if( rhs.heaped_ ) {
                 heaped_.reset( new T{ *rhs.heaped_ } );
             } else {
-                heaped_.reset( new T{} );
+                heaped_.reset();
             }
             return *this;
         }
@@ -112,16 +124,16 @@ struct heap {
         // Implicit conversion functions
         // NOLINTNEXTLINE(google-explicit-constructor)
         operator T &() & { // *NOPAD*
-            return *heaped_;
+            return val();
         }
         // NOLINTNEXTLINE(google-explicit-constructor)
         operator T const &() const & { // *NOPAD*
-            return *heaped_;
+            return val();
         }
         // Intentionally move construct a value T to avoid binding a ref to a temporary.
         // NOLINTNEXTLINE(google-explicit-constructor)
         operator T() && { // *NOPAD*
-            return std::move( *heaped_ );
+            return heaped_ ? std::move( *heaped_ ) : T{};
         }
 
         // The one weird one: since this is ultimately backed on the heap,
@@ -130,23 +142,26 @@ struct heap {
         // to peel back the heap<> wrapper because otherwise template type deduction
         // might break.
         T &operator*() & { // *NOPAD*
-            return *heaped_;
+            return val();
         }
         T const &operator*() const & { // *NOPAD*
-            return *heaped_;
+            return val();
         }
         // Intentionally move construct a value T to avoid binding a ref to a temporary.
         T operator*() && { // *NOPAD*
-            return std::move( *heaped_ );
+            return heaped_ ? std::move( *heaped_ ) : T{};
         }
 
     private:
         // Helper for proxy functions.
         T &val() {
+            if( !heaped_ ) {
+                heaped_.reset( new T{} );
+            }
             return *heaped_;
         }
         T const &val() const {
-            return *heaped_;
+            return heaped_ ? *heaped_ : empty_value();
         }
     public:
 
@@ -166,17 +181,11 @@ struct heap {
 
         // Comparison operators.
         auto operator==( heap const &rhs ) const -> decltype( val() == val() ) {
-            const T *lhsp = heaped_.get();
-            const T *rhsp = rhs.heaped_.get();
-
-            return rhsp && lhsp && *rhsp == *lhsp;
+            return val() == rhs.val();
         }
 
         auto operator!=( heap const &rhs ) const -> decltype( val() != val() ) {
-            const T *lhsp = heaped_.get();
-            const T *rhsp = rhs.heaped_.get();
-
-            return rhsp && lhsp && *rhsp != *lhsp;
+            return val() != rhs.val();
         }
 
 
@@ -184,7 +193,11 @@ struct heap {
         PROXY_CONST( empty )
         PROXY_CONST( count )
         PROXY_CONST( size )
-        PROXY( clear )
+        void clear() {
+            if( heaped_ ) {
+                heaped_->clear();
+            }
+        }
 
         // Iterators
         PROXY( begin )
@@ -201,7 +214,17 @@ struct heap {
         PROXY( find )
         PROXY_CONST( find )
 
-        PROXY( erase )
+        template<typename ...Us>
+        auto erase( Us &&...us ) -> decltype( val().erase( std::forward<Us>( us )... ) ) {
+            using result = decltype( val().erase( std::forward<Us>( us )... ) );
+            if constexpr( std::is_integral_v<result> ) {
+                // Erasing a key from an unallocated heap erases nothing
+                if( !heaped_ ) {
+                    return 0;
+                }
+            }
+            return val().erase( std::forward<Us>( us )... );
+        }
         PROXY( insert )
         PROXY( emplace )
 
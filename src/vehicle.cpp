@@ -205,6 +205,10 @@ units::volume vehicle_stack::max_volume() const
     return std::min( vpi.size, 10000_liter );
 }
 
+// Bumped whenever a vehicle is refreshed, moved or destroyed, which invalidates every
+// vehicle::power_network built before
+static int64_t power_network_generation = 0;
+
 // Vehicle class methods.
 
 vehicle::vehicle( const vproto_id &proto_id )
@@ -229,7 +233,10 @@ vehicle::vehicle( const vproto_id &proto_id )
     }
 }
 
-vehicle::~vehicle() = default;
+vehicle::~vehicle()
+{
+    power_network_generation++;
+}
 
 turret_cpu::~turret_cpu() = default;
 
@@ -3438,7 +3445,7 @@ int64_t vehicle::fuel_left( const itype_id &ftype,
 {
     int64_t fl = 0;
     if( ftype == fuel_type_battery ) {
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *const, float> &pair : get_power_network().vehicles ) {
             const vehicle &veh = *pair.first;
             const float loss = pair.second;
             for( const int part_idx : veh.batteries ) {
@@ -3502,7 +3509,7 @@ int vehicle::fuel_capacity( const itype_id &ftype ) const
 {
     if( ftype == fuel_type_battery ) { // batteries get special treatment due to power cables
         int64_t capacity = 0;
-        for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+        for( const std::pair<vehicle *const, float> &pair : get_power_network().vehicles ) {
             const vehicle &veh = *pair.first;
             for( const int part_idx : veh.batteries ) {
                 const vehicle_part &vp = veh.parts[part_idx];
@@ -4948,7 +4955,7 @@ std::pair<int, int> vehicle::connected_battery_power_level() const
     int total_epower_remaining = 0;
     int total_epower_capacity = 0;
 
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *const, float> &pair : get_power_network().vehicles ) {
         int epower_remaining;
         int epower_capacity;
         std::tie( epower_remaining, epower_capacity ) = pair.first->battery_power_level();
@@ -5155,6 +5162,7 @@ void vehicle::update_alternator_load()
 
 void vehicle::power_parts()
 {
+    last_powered = calendar::turn;
     update_alternator_load();
     // Things that drain energy: engines and accessories.
     units::power engine_epower = total_engine_epower();
@@ -5330,14 +5338,38 @@ std::map<Vehicle *, float> vehicle::search_connected_vehicles( Vehicle *start )
     return distances;
 }
 
+const vehicle::power_network &vehicle::get_power_network() const
+{
+    power_network &net = power_network_cache;
+    if( net.generation == power_network_generation && net.root == this ) {
+        return net;
+    }
+    // The connected vehicles aren't const, only this one is
+    net.vehicles = search_connected_vehicles( const_cast<vehicle *>( this ) );
+    net.batteries.clear();
+    for( const std::pair<vehicle *const, float> &pair : net.vehicles ) {
+        for( const int part_idx : pair.first->batteries ) {
+            if( !pair.first->part( part_idx ).is_fake ) {
+                net.batteries.push_back( { pair.first, part_idx, pair.second } );
+            }
+        }
+    }
+    // Loading the submaps of connected vehicles may have bumped the generation, but the
+    // search has seen those vehicles already
+    net.generation = power_network_generation;
+    net.root = this;
+    return net;
+}
+
 std::map<vehicle *, float> vehicle::search_connected_vehicles()
 {
-    return search_connected_vehicles( this );
+    return get_power_network().vehicles;
 }
 
 std::map<const vehicle *, float> vehicle::search_connected_vehicles() const
 {
-    return search_connected_vehicles( this );
+    const std::map<vehicle *, float> &vehicles = get_power_network().vehicles;
+    return std::map<const vehicle *, float>( vehicles.begin(), vehicles.end() );
 }
 
 void vehicle::get_connected_vehicles( std::unordered_set<vehicle *> &dest )
@@ -5363,43 +5395,34 @@ std::map<vpart_reference, float> vehicle::search_connected_batteries()
 {
     std::map<vpart_reference, float> result;
 
-    for( const std::pair<vehicle *const, float> &pair : search_connected_vehicles() ) {
-        vehicle *veh = pair.first;
-        const float efficiency = pair.second;
-        for( const int part_idx : veh->batteries ) {
-            const vpart_reference vpr( *veh, part_idx );
-            if( vpr.part().is_fake ) {
-                continue;
-            }
-            result.emplace( vpr, efficiency );
-        }
+    for( const power_network::battery &bat : get_power_network().batteries ) {
+        result.emplace( vpart_reference( *bat.veh, bat.part ), bat.loss );
     }
 
     return result;
 }
 
 // helper method to calculate power loss weighted by capacity
-static double weighted_power_loss( const std::map<vpart_reference, float> &batteries )
+static double weighted_power_loss( const std::vector<vehicle::power_network::battery> &batteries )
 {
     double res = 0.0; // sum of power losses
     int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
-        const int capacity = vp.ammo_capacity( ammo_battery );
+    for( const vehicle::power_network::battery &bat : batteries ) {
+        const int capacity = bat.veh->part( bat.part ).ammo_capacity( ammo_battery );
         total_capacity += capacity;
-        res += pair.second * capacity;
+        res += bat.loss * capacity;
     }
     return res / total_capacity;
 }
 
-// helper method to take a map of batteries, amount of charge, total capacity of batteries
+// helper method to take a list of batteries, amount of charge, total capacity of batteries
 // and distribute given charge_kj over the batteries as evenly as possible
-static void distribute_charge_evenly( const std::map<vpart_reference, float> &batteries,
+static void distribute_charge_evenly( const std::vector<vehicle::power_network::battery> &batteries,
                                       int64_t charge_kj, int64_t total_capacity_kj )
 {
     int64_t distributed = 0;
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
+    for( const vehicle::power_network::battery &bat : batteries ) {
+        vehicle_part &vp = bat.veh->part( bat.part );
         const int bat_capacity = vp.ammo_capacity( ammo_battery );
         const float fraction = static_cast<float>( bat_capacity ) / total_capacity_kj;
         const int portion = charge_kj * fraction;
@@ -5407,8 +5430,8 @@ static void distribute_charge_evenly( const std::map<vpart_reference, float> &ba
         distributed += portion;
     }
     if( distributed < charge_kj ) { // dump indivisible remainder sequentially
-        for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-            vehicle_part &vp = pair.first.part();
+        for( const vehicle::power_network::battery &bat : batteries ) {
+            vehicle_part &vp = bat.veh->part( bat.part );
             const int64_t bat_charge = vp.ammo_remaining();
             const int64_t bat_capacity = vp.ammo_capacity( ammo_battery );
             const int chargeable = std::min( charge_kj - distributed, bat_capacity - bat_charge );
@@ -5427,7 +5450,7 @@ static void distribute_charge_evenly( const std::map<vpart_reference, float> &ba
 int64_t vehicle::battery_left( bool apply_loss ) const
 {
     int64_t ret = 0;
-    for( const std::pair<const vehicle *const, float> &pair : search_connected_vehicles() ) {
+    for( const std::pair<vehicle *const, float> &pair : get_power_network().vehicles ) {
         const vehicle &veh = *pair.first;
         const float efficiency = 1.0f - ( apply_loss ? pair.second : 0.0f );
         for( const int part_idx : veh.batteries ) {
@@ -5447,15 +5470,15 @@ int vehicle::charge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
+    const std::vector<power_network::battery> &batteries = get_power_network().batteries;
     if( batteries.empty() ) {
         return amount;
     }
     const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
     int64_t total_charge = 0; // sum of current charge of all batteries
     int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
+    for( const power_network::battery &bat : batteries ) {
+        const vehicle_part &vp = bat.veh->part( bat.part );
         total_charge += vp.ammo_remaining();
         total_capacity += vp.ammo_capacity( ammo_battery );
     }
@@ -5490,15 +5513,15 @@ int vehicle::discharge_battery( int amount, bool apply_loss )
     if( amount == 0 ) {
         return 0;
     }
-    const std::map<vpart_reference, float> batteries = search_connected_batteries();
+    const std::vector<power_network::battery> &batteries = get_power_network().batteries;
     if( batteries.empty() ) {
         return amount;
     }
     const double loss = apply_loss ? weighted_power_loss( batteries ) : 0.0;
     int64_t total_charge = 0; // sum of current charge of all batteries
     int64_t total_capacity = 0; // sum of capacity of all batteries
-    for( const std::pair<const vpart_reference, float> &pair : batteries ) {
-        vehicle_part &vp = pair.first.part();
+    for( const power_network::battery &bat : batteries ) {
+        const vehicle_part &vp = bat.veh->part( bat.part );
         total_charge += vp.ammo_remaining();
         total_capacity += vp.ammo_capacity( ammo_battery );
     }
@@ -6098,6 +6121,7 @@ void vehicle::refresh_active_item_cache()
  */
 void vehicle::refresh( const bool remove_fakes )
 {
+    power_network_generation++;
     if( no_refresh ) {
         return;
     }
@@ -7809,17 +7833,96 @@ void vehicle::update_time( const time_point &update_to )
         // We don't need to check every turn
         return;
     }
-    time_duration elapsed = update_to - last_update;
     last_update = update_to;
 
+    // Accessories are powered by power_parts every turn the vehicle is in the bubble, so they are
+    // only caught up for the time since it left the bubble
+    const time_point accessories_from = std::max( update_from, last_powered );
+    const bool catch_up_accessories = accessories_from < update_to &&
+                                      total_accessory_epower() != 0_W;
+
     // Weather stuff, only for z-levels >= 0
     // TODO: Have it wash cars from blood?
-    if( funnels.empty() && solar_panels.empty() && wind_turbines.empty() && water_wheels.empty() ) {
+    if( funnels.empty() && solar_panels.empty() && wind_turbines.empty() && water_wheels.empty() &&
+        !catch_up_accessories ) {
         return;
     }
+
+    // Batteries fill up by day and drain by night, so after a few days they settle wherever the
+    // net energy of a day takes them.  The days before the last one are taken as a whole and the
+    // last day an hour at a time, which is at most 25 steps however long the vehicle was away.
+    std::vector<time_point> steps = { update_from };
+    const time_point last_day = std::max( update_from, update_to - 1_days );
+    if( last_day > update_from ) {
+        steps.push_back( last_day );
+    }
+    const int hours = std::clamp( to_hours<int>( update_to - last_day ), 1, 24 );
+    for( int i = 1; i <= hours; i++ ) {
+        steps.push_back( last_day + ( update_to - last_day ) * i / hours );
+    }
+
+    units::power solar_epower = 0_W;
+    for( const int p : solar_panels ) {
+        const vehicle_part &vp = parts[p];
+        const tripoint pos = global_part_pos3( vp );
+        if( vp.is_unavailable() || !is_sm_tile_outside( here.getabs( pos ) ) ) {
+            continue;
+        }
+        solar_epower += part_epower( vp );
+    }
+    // TODO: use the weather data to backfill wind turbine generation capacity, and river current
+    // for water wheels.
+    const units::power generated_epower = total_wind_epower() + total_water_wheel_epower();
+    units::power accessory_epower = catch_up_accessories ? total_accessory_epower() : 0_W;
+    const bool needs_weather = !funnels.empty() || solar_epower > 0_W;
+
     // Get one weather data set per vehicle, they don't differ much across vehicle area
-    const weather_sum accum_weather = sum_conditions( update_from, update_to,
-                                      global_square_location() );
+    weather_sum accum_weather;
+    // Rounded once over all the steps, so that splitting the time doesn't skew the total
+    double exact_energy_kj = 0.0;
+    int net_energy_bat = 0;
+    for( size_t i = 0; i + 1 < steps.size(); i++ ) {
+        const time_duration step = steps[i + 1] - steps[i];
+        const time_duration accessory_time = std::max( 0_turns,
+                                             steps[i + 1] - std::max( steps[i], accessories_from ) );
+        units::power epower = generated_epower;
+        if( needs_weather ) {
+            const weather_sum step_weather = sum_conditions( steps[i], steps[i + 1],
+                                             global_square_location() );
+            accum_weather.rain_amount += step_weather.rain_amount;
+            accum_weather.sunlight += step_weather.sunlight;
+            accum_weather.radiant_exposure += step_weather.radiant_exposure;
+            accum_weather.wind_amount += step_weather.wind_amount;
+            const double intensity = step_weather.radiant_exposure / max_sun_irradiance() /
+                                     to_seconds<float>( step );
+            epower += solar_epower * intensity;
+        }
+        exact_energy_kj += units::to_millijoule( epower * step + accessory_epower * accessory_time ) /
+                           1000000.0;
+        const int rounded = i + 2 == steps.size() ? roll_remainder( exact_energy_kj ) :
+                            static_cast<int>( exact_energy_kj );
+        const int energy_bat = rounded - net_energy_bat;
+        net_energy_bat = rounded;
+        if( energy_bat > 0 ) {
+            charge_battery( energy_bat );
+        } else if( energy_bat < 0 && discharge_battery( -energy_bat ) != 0 ) {
+            // The batteries went flat, which turns off what drains them just like power_parts
+            for( const vpart_reference &vp : get_enabled_parts( VPFLAG_ENABLED_DRAINS_EPOWER ) ) {
+                if( vp.part().info().epower < 0_W ) {
+                    vp.part().enabled = false;
+                }
+            }
+            accessory_epower = catch_up_accessories ? total_accessory_epower() : 0_W;
+        }
+    }
+    if( net_energy_bat != 0 ) {
+        add_msg_debug( debugmode::DF_VEHICLE, "%s got %d kJ net energy over %d steps while away", name,
+                       net_energy_bat, steps.size() - 1 );
+    }
+
+    if( funnels.empty() ) {
+        return;
+    }
     // make some reference objects to use to check for reload
     const item water( "water" );
     const item water_clean( "water_clean" );
@@ -7860,43 +7963,6 @@ void vehicle::update_time( const time_point &update_to )
             invalidate_mass();
         }
     }
-
-    if( !solar_panels.empty() ) {
-        units::power epower = 0_W;
-        for( const int p : solar_panels ) {
-            const vehicle_part &vp = parts[p];
-            const tripoint pos = global_part_pos3( vp );
-            if( vp.is_unavailable() || !is_sm_tile_outside( here.getabs( pos ) ) ) {
-                continue;
-            }
-            epower += part_epower( vp );
-        }
-        double intensity = accum_weather.radiant_exposure / max_sun_irradiance() / to_seconds<float>
-                           ( elapsed );
-        int energy_bat = power_to_energy_bat( epower * intensity, elapsed );
-        if( energy_bat > 0 ) {
-            add_msg_debug( debugmode::DF_VEHICLE, "%s got %d kJ energy from solar panels", name, energy_bat );
-            charge_battery( energy_bat );
-        }
-    }
-    if( !wind_turbines.empty() ) {
-        // TODO: use accum_weather wind data to backfill wind turbine
-        // generation capacity.
-        units::power epower = total_wind_epower();
-        int energy_bat = power_to_energy_bat( epower, elapsed );
-        if( energy_bat > 0 ) {
-            add_msg_debug( debugmode::DF_VEHICLE, "%s got %d kJ energy from wind turbines", name, energy_bat );
-            charge_battery( energy_bat );
-        }
-    }
-    if( !water_wheels.empty() ) {
-        units::power epower = total_water_wheel_epower();
-        int energy_bat = power_to_energy_bat( epower, elapsed );
-        if( energy_bat > 0 ) {
-            add_msg_debug( debugmode::DF_VEHICLE, "%s got %d kJ energy from water wheels", name, energy_bat );
-            charge_battery( energy_bat );
-        }
-    }
 }
 
 void vehicle::invalidate_mass()
@@ -8071,6 +8137,7 @@ std::set<int> vehicle::advance_precalc_mounts( const point &new_pos, const tripo
         std::set<int> parts_to_move )
 {
     map &here = get_map();
+    power_network_generation++;
     std::set<int> smzs;
     // when a vehicle part enters the low end of a down ramp, or the high end of an up ramp,
     // it immediately translates down or up a z-level, respectively, ending up on the low
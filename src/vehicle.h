@@ -860,6 +860,30 @@ class vehicle
         /// Templated to support const and non-const vehicle*
         template<typename Vehicle>
         static std::map<Vehicle *, float> search_connected_vehicles( Vehicle *start );
+
+    public:
+        /**
+         * The vehicles and batteries reached from a vehicle through POWER_TRANSFER parts. It is
+         * kept until a vehicle anywhere is refreshed, moved or destroyed, which is when cables
+         * and batteries can come and go, so drawing power doesn't walk the network every time.
+         */
+        struct power_network {
+            struct battery {
+                vehicle *veh;
+                int part;
+                float loss;
+            };
+            int64_t generation = -1;
+            // The vehicle it was built for, a vehicle that was moved into doesn't own it
+            const vehicle *root = nullptr;
+            std::map<vehicle *, float> vehicles;
+            // Batteries that aren't fake, in the order of the vehicles and their parts
+            std::vector<battery> batteries;
+        };
+    private:
+        mutable power_network power_network_cache; // NOLINT(cata-serialize)
+        /** Rebuilds @ref power_network_cache if anything may have changed since it was built */
+        const power_network &get_power_network() const;
     public:
         /**
          * Find a possibly off-map vehicle. If necessary, loads up its submap through
@@ -2092,7 +2116,7 @@ class vehicle
 
         bounding_box get_bounding_box( bool use_precalc = true, bool no_fake = false );
         // Retroactively pass time spent outside bubble
-        // Funnels, solar panels
+        // Funnels, solar panels, wind turbines, water wheels and the accessories they power
         void update_time( const time_point &update_to );
 
         // The faction that owns this vehicle.
@@ -2261,6 +2285,8 @@ class vehicle
         int alternator_load = 0; // NOLINT(cata-serialize)
         // Turn the vehicle was last processed
         time_point last_update = calendar::before_time_starts;
+        // Turn power_parts last ran, accessory loads up to it are already paid for
+        time_point last_powered = calendar::before_time_starts; // NOLINT(cata-serialize)
         // save values
         /**
          * Position of the vehicle *inside* the submap that contains the vehicle.
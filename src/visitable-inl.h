@@ -0,0 +1,136 @@
+#pragma once
+#ifndef CATA_SRC_VISITABLE_INL_H
+#define CATA_SRC_VISITABLE_INL_H
+
+#include <list>
+#include <vector>
+
+#include "character.h"
+#include "character_attire.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_contents.h"
+#include "item_pocket.h"
+#include "pimpl.h"
+#include "pocket_type.h"
+#include "visitable.h"
+
+/**
+ * Templated counterparts of the visitable traversal, for the hot loops that visit every item
+ * a character or inventory holds.  The visitor is a template parameter instead of a
+ * std::function, so it is inlined into the recursion instead of being called indirectly for
+ * every item.  The std::function visit_items and visit_contents overloads forward here, so
+ * both visit the same items in the same order and follow the same VisitResponse rules.
+ */
+
+namespace visitable_detail
+{
+template<typename Visitor>
+VisitResponse visit_node( Visitor &func, const item *node, item *parent = nullptr )
+{
+    // hack to avoid repetition
+    item *m_node = const_cast<item *>( node );
+
+    switch( func( m_node, parent ) ) {
+        case VisitResponse::ABORT:
+            return VisitResponse::ABORT;
+
+        case VisitResponse::NEXT:
+            if( m_node->visit_contents_inline( func, m_node ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        /* intentional fallthrough */
+
+        case VisitResponse::SKIP:
+            return VisitResponse::NEXT;
+    }
+
+    /* never reached but suppresses GCC warning */
+    return VisitResponse::ABORT;
+}
+} // namespace visitable_detail
+
+template<typename Visitor>
+VisitResponse item_pocket::visit_contents_inline( Visitor &func, item *parent )
+{
+    for( item &e : contents ) {
+        if( visitable_detail::visit_node( func, &e, parent ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename Visitor>
+VisitResponse item_contents::visit_contents_inline( Visitor &func, item *parent )
+{
+    for( item_pocket &pocket : contents ) {
+        if( !pocket.is_type( pocket_type::CONTAINER ) ) {
+            // anything that is not CONTAINER is accessible only via its specific accessor
+            continue;
+        }
+        if( pocket.visit_contents_inline( func, parent ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename Visitor>
+VisitResponse item::visit_contents_inline( Visitor &func, item *parent )
+{
+    return contents.visit_contents_inline( func, parent );
+}
+
+template<typename Visitor>
+VisitResponse item::visit_items_inline( Visitor &&func ) const
+{
+    return visitable_detail::visit_node( func, this );
+}
+
+template<typename Visitor>
+VisitResponse inventory::visit_items_inline( Visitor &&func ) const
+{
+    for( const std::list<item> &stack : items ) {
+        for( const item &it : stack ) {
+            if( visitable_detail::visit_node( func, &it ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename Visitor>
+VisitResponse outfit::visit_items_inline( Visitor &func ) const
+{
+    for( const item &e : worn ) {
+        if( visitable_detail::visit_node( func, &e ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+    return VisitResponse::NEXT;
+}
+
+template<typename Visitor>
+VisitResponse Character::visit_items_inline( Visitor &&func ) const
+{
+    if( !weapon.is_null() &&
+        visitable_detail::visit_node( func, &weapon ) == VisitResponse::ABORT ) {
+        return VisitResponse::ABORT;
+    }
+
+    if( worn.visit_items_inline( func ) == VisitResponse::ABORT ) {
+        return VisitResponse::ABORT;
+    }
+
+    for( const item *e : get_pseudo_items() ) {
+        if( visitable_detail::visit_node( func, e ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+
+    return inv->visit_items_inline( func );
+}
+
+#endif // CATA_SRC_VISITABLE_INL_H
@@ -36,6 +36,7 @@
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vehicle_selector.h"
+#include "visitable-inl.h"
 
 static const bionic_id bio_ups( "bio_ups" );
 
@@ -104,12 +105,37 @@ static T sum_no_wrap( T a, T b )
     return a + b;
 }
 
+// Visits with the inlined traversal when the type being visited has one
+template <typename T, typename Visitor>
+static VisitResponse visit_items_of( const T &self, Visitor &&func )
+{
+    return self.visit_items( func );
+}
+
+template <typename Visitor>
+static VisitResponse visit_items_of( const item &self, Visitor &&func )
+{
+    return self.visit_items_inline( func );
+}
+
+template <typename Visitor>
+static VisitResponse visit_items_of( const inventory &self, Visitor &&func )
+{
+    return self.visit_items_inline( func );
+}
+
+template <typename Visitor>
+static VisitResponse visit_items_of( const Character &self, Visitor &&func )
+{
+    return self.visit_items_inline( func );
+}
+
 template <typename T>
 static int has_quality_internal( const T &self, const quality_id &qual, int level, int limit )
 {
     int qty = 0;
 
-    self.visit_items( [&qual, level, &limit, &qty]( item * e, item * ) {
+    visit_items_of( self, [&qual, level, &limit, &qty]( item * e, item * ) {
         if( e->get_quality( qual ) >= level ) {
             qty = sum_no_wrap( qty, static_cast<int>( e->count() ) );
             if( qty >= limit ) {
@@ -230,7 +256,7 @@ template <typename T>
 static int max_quality_internal( const T &self, const quality_id &qual )
 {
     int res = INT_MIN;
-    self.visit_items( [&res, &qual]( item * e, item * ) {
+    visit_items_of( self, [&res, &qual]( item * e, item * ) {
         res = std::max( res, e->get_quality( qual ) );
         return VisitResponse::NEXT;
     } );
@@ -317,7 +343,7 @@ static inline std::vector<T> items_with_internal( V &self, const std::function<b
         &filter )
 {
     std::vector<T> res;
-    self.visit_items( [&res, &filter]( const item * node, item * ) {
+    visit_items_of( self, [&res, &filter]( const item * node, item * ) {
         if( filter( *node ) ) {
             res.push_back( const_cast<T>( node ) );
         }
@@ -339,87 +365,36 @@ std::vector<item *> read_only_visitable::items_with(
     return items_with_internal<item *>( *this, filter );
 }
 
-static VisitResponse visit_internal( const std::function<VisitResponse( item *, item * )> &func,
-                                     const item *node, item *parent = nullptr )
-{
-    // hack to avoid repetition
-    item *m_node = const_cast<item *>( node );
-
-    switch( func( m_node, parent ) ) {
-        case VisitResponse::ABORT:
-            return VisitResponse::ABORT;
-
-        case VisitResponse::NEXT:
-            if( m_node->visit_contents( func, m_node ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        /* intentional fallthrough */
-
-        case VisitResponse::SKIP:
-            return VisitResponse::NEXT;
-    }
-
-    /* never reached but suppresses GCC warning */
-    return VisitResponse::ABORT;
-}
-
 VisitResponse item::visit_contents( const std::function<VisitResponse( item *, item * )>
                                     &func, item *parent )
 {
-    return contents.visit_contents( func, parent );
+    return visit_contents_inline( func, parent );
 }
 
 VisitResponse item_contents::visit_contents( const std::function<VisitResponse( item *, item * )>
         &func, item *parent )
 {
-    for( item_pocket &pocket : contents ) {
-        if( !pocket.is_type( pocket_type::CONTAINER ) ) {
-            // anything that is not CONTAINER is accessible only via its specific accessor
-            continue;
-        }
-        switch( pocket.visit_contents( func, parent ) ) {
-            case VisitResponse::ABORT:
-                return VisitResponse::ABORT;
-            default:
-                break;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_contents_inline( func, parent );
 }
 
 VisitResponse item_pocket::visit_contents( const std::function<VisitResponse( item *, item * )>
         &func, item *parent )
 {
-    for( item &e : contents ) {
-        switch( visit_internal( func, &e, parent ) ) {
-            case VisitResponse::ABORT:
-                return VisitResponse::ABORT;
-            default:
-                break;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_contents_inline( func, parent );
 }
 
 /** @relates visitable */
 VisitResponse item::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    return visit_internal( func, this );
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
 VisitResponse inventory::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
-    for( const auto &stack : items ) {
-        for( const item &it : stack ) {
-            if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
@@ -427,7 +402,7 @@ VisitResponse temp_crafting_inventory::visit_items(
     const std::function<VisitResponse( item *, item * )> &func ) const
 {
     for( item *it : items ) {
-        if( visit_internal( func, it ) == VisitResponse::ABORT ) {
+        if( visitable_detail::visit_node( func, it ) == VisitResponse::ABORT ) {
             return VisitResponse::ABORT;
         }
     }
@@ -437,34 +412,14 @@ VisitResponse temp_crafting_inventory::visit_items(
 VisitResponse outfit::visit_items( const std::function<VisitResponse( item *, item * )> &func )
 const
 {
-    for( const item &e : worn ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
 VisitResponse Character::visit_items( const std::function<VisitResponse( item *, item * )> &func )
 const
 {
-    if( !weapon.is_null() &&
-        visit_internal( func, &weapon ) == VisitResponse::ABORT ) {
-        return VisitResponse::ABORT;
-    }
-
-    if( worn.visit_items( func ) == VisitResponse::ABORT ) {
-        return VisitResponse::ABORT;
-    }
-
-    for( const item *e : get_pseudo_items() ) {
-        if( visit_internal( func, e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-
-    return inv->visit_items( func );
+    return visit_items_inline( func );
 }
 
 /** @relates visitable */
@@ -479,7 +434,7 @@ VisitResponse map_cursor::visit_items(
         itype_id it_id = here.furn( p )->crafting_pseudo_item;
         if( it_id.is_valid() ) {
             item it( it_id );
-            if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
+            if( visitable_detail::visit_node( func, &it ) == VisitResponse::ABORT ) {
                 return VisitResponse::ABORT;
             }
         }
@@ -492,7 +447,7 @@ VisitResponse map_cursor::visit_items(
     }
 
     for( item &e : here.i_at( p ) ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
+        if( visitable_detail::visit_node( func, &e ) == VisitResponse::ABORT ) {
             return VisitResponse::ABORT;
         }
     }
@@ -519,7 +474,7 @@ VisitResponse vehicle_cursor::visit_items(
     const int idx = veh.part_with_feature( vp.mount, "CARGO", true );
     if( idx >= 0 ) {
         for( item &e : veh.get_items( veh.part( idx ) ) ) {
-            if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
+            if( visitable_detail::visit_node( func, &e ) == VisitResponse::ABORT ) {
                 return VisitResponse::ABORT;
             }
         }
@@ -805,7 +760,7 @@ static int charges_of_internal( const T &self, const M &main, const itype_id &id
 
     bool found_tool_with_UPS = false;
     bool found_bionic_tool = false;
-    self.visit_items( [&]( const item * e, item * ) {
+    visit_items_of( self, [&]( const item * e, item * ) {
         if( filter( *e ) &&
             ( id == e->typeId() || ( in_tools && id == e->ammo_current() ) ||
               ( id == itype_UPS && e->has_flag( flag_IS_UPS ) ) ) &&
@@ -858,7 +813,7 @@ static std::pair<int, int> kcal_range_of_internal( const T &self, const itype_id
         const std::function<bool( const item & )> &filter, Character &player_character )
 {
     std::pair<int, int> result( INT_MAX, INT_MIN );
-    self.visit_items( [&result, &id, &filter, &player_character]( const item * e, item * ) {
+    visit_items_of( self, [&result, &id, &filter, &player_character]( const item * e, item * ) {
         if( e->typeId() == id && filter( *e ) ) {
             int kcal = player_character.compute_effective_nutrients( *e ).kcal();
             if( kcal < result.first ) {
@@ -923,6 +878,27 @@ int inventory::charges_of( const itype_id &what, int limit,
     return std::min( limit, res );
 }
 
+namespace
+{
+/**
+ * Visits the items of one type that a character has, found through its inventory search cache
+ * rather than by walking everything it carries.  Nested items aren't visited separately, the
+ * cache already holds every item of the type at any depth.  The cache is rebuilt whenever any
+ * item changed type or had items put in it since, so none are missed.
+ */
+struct cached_items_of_type {
+    const Character &who;
+    const itype_id &id;
+
+    VisitResponse visit_items( const std::function<VisitResponse( item *, item * )> &func ) const {
+        const bool aborted = who.cache_has_item_with_exact( id, [&func]( const item & it ) {
+            return func( const_cast<item *>( &it ), nullptr ) == VisitResponse::ABORT;
+        } );
+        return aborted ? VisitResponse::ABORT : VisitResponse::NEXT;
+    }
+};
+} // namespace
+
 /** @relates visitable */
 int Character::charges_of( const itype_id &what, int limit,
                            const std::function<bool( const item & )> &filter,
@@ -936,6 +912,10 @@ int Character::charges_of( const itype_id &what, int limit,
         }
         return std::min( ups_power, limit );
     }
+    if( !in_tools ) {
+        return charges_of_internal( cached_items_of_type{ *this, what }, *this, what, limit, filter,
+                                    visitor, false );
+    }
     return charges_of_internal( *this, *this, what, limit, filter, visitor, in_tools );
 }
 
@@ -944,7 +924,7 @@ static int amount_of_internal( const T &self, const itype_id &id, bool pseudo, i
                                const std::function<bool( const item & )> &filter )
 {
     int qty = 0;
-    self.visit_items( [&qty, &id, &pseudo, &limit, &filter]( const item * e, item * ) {
+    visit_items_of( self, [&qty, &id, &pseudo, &limit, &filter]( const item * e, item * ) {
         if( !e->has_flag( STATIC( flag_id( "ITEM_BROKEN" ) ) ) &&
             ( id == STATIC( itype_id( "any" ) ) || e->typeId() == id ) && filter( *e ) &&
             ( pseudo || !e->has_flag( STATIC( flag_id( "PSEUDO" ) ) ) ) ) {
@@ -1011,6 +991,9 @@ int Character::amount_of( const itype_id &what, bool pseudo, int limit,
         return std::min( qty, limit );
     }
 
+    if( what != STATIC( itype_id( "any" ) ) ) {
+        return amount_of_internal( cached_items_of_type{ *this, what }, what, pseudo, limit, filter );
+    }
     return amount_of_internal( *this, what, pseudo, limit, filter );
 }
 
@@ -409,3 +409,12 @@ TEST_CASE( "lcmatch", "[utility][nogame]" )
     CHECK( lcmatch( "無効", "無" ) == true );
     CHECK( lcmatch( "無効", "無效" ) == false );
 }
+
+TEST_CASE( "lcmatch_query_matches_like_lcmatch", "[utility][nogame]" )
+{
+    const lcmatch_query query( "Bo" );
+    CHECK( query.matches( "bo" ) );
+    CHECK( query.matches( "BŌ" ) );
+    CHECK_FALSE( query.matches( "co" ) );
+    CHECK( lcmatch_query( "" ).matches( "anything" ) );
+}
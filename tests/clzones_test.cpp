@@ -1,12 +1,18 @@
 #include <iosfwd>
+#include <unordered_set>
 #include <vector>
 
 #include "activity_actor_definitions.h"
+#include "activity_handlers.h"
 #include "avatar.h"
+#include "calendar.h"
+#include "cata_scope_helpers.h"
 #include "cata_catch.h"
+#include "character.h"
 #include "clzones.h"
 #include "item.h"
 #include "item_category.h"
+#include "map.h"
 #include "map_helpers.h"
 #include "player_helpers.h"
 #include "pocket_type.h"
@@ -15,11 +21,20 @@
 #include "type_id.h"
 
 static const activity_id ACT_MOVE_LOOT( "ACT_MOVE_LOOT" );
+static const activity_id ACT_MULTIPLE_CHOP_TREES( "ACT_MULTIPLE_CHOP_TREES" );
+static const activity_id ACT_MULTIPLE_FARM( "ACT_MULTIPLE_FARM" );
+
 static const faction_id faction_your_followers( "your_followers" );
 
+static const furn_str_id furn_f_chair( "f_chair" );
+
 static const itype_id itype_556( "556" );
 static const itype_id itype_ammolink223( "ammolink223" );
 static const itype_id itype_belt223( "belt223" );
+static const itype_id itype_rock( "rock" );
+
+static const ter_str_id ter_t_dirt( "t_dirt" );
+static const ter_str_id ter_t_dirtmound( "t_dirtmound" );
 
 static const vproto_id vehicle_prototype_shopping_cart( "shopping_cart" );
 
@@ -27,6 +42,7 @@ static const zone_type_id zone_type_LOOT_DRINK( "LOOT_DRINK" );
 static const zone_type_id zone_type_LOOT_FOOD( "LOOT_FOOD" );
 static const zone_type_id zone_type_LOOT_PDRINK( "LOOT_PDRINK" );
 static const zone_type_id zone_type_LOOT_PFOOD( "LOOT_PFOOD" );
+static const zone_type_id zone_type_LOOT_SPARE_PARTS( "LOOT_SPARE_PARTS" );
 static const zone_type_id zone_type_LOOT_UNSORTED( "LOOT_UNSORTED" );
 static const zone_type_id zone_type_UNLOAD_ALL( "UNLOAD_ALL" );
 
@@ -315,3 +331,113 @@ TEST_CASE( "zone_sorting_comestibles_", "[zones][items][food][activities]" )
         }
     }
 }
+
+TEST_CASE( "zone_queries_use_the_extent_of_zones", "[zones]" )
+{
+    clear_map();
+    map &here = get_map();
+    zone_manager &zmgr = zone_manager::get_manager();
+    const tripoint start = here.getabs( tripoint( 10, 10, 0 ) );
+    const tripoint end = here.getabs( tripoint( 19, 19, 0 ) );
+    mapgen_place_zone( start, end, zone_type_LOOT_FOOD, your_fac );
+    // three tiles west of the middle of the zone
+    const tripoint_abs_ms where = here.getglobal( tripoint( 7, 15, 0 ) );
+
+    CHECK( zmgr.has( zone_type_LOOT_FOOD, here.getglobal( tripoint( 15, 15, 0 ) ) ) );
+    CHECK_FALSE( zmgr.has( zone_type_LOOT_FOOD, where ) );
+    CHECK_FALSE( zmgr.has( zone_type_LOOT_DRINK, here.getglobal( tripoint( 15, 15, 0 ) ) ) );
+
+    CHECK_FALSE( zmgr.has_near( zone_type_LOOT_FOOD, where, 2 ) );
+    CHECK( zmgr.has_near( zone_type_LOOT_FOOD, where, 3 ) );
+
+    CHECK_FALSE( zmgr.get_nearest( zone_type_LOOT_FOOD, where, 2 ) );
+    CHECK( zmgr.get_nearest( zone_type_LOOT_FOOD, where, 3 ) ==
+           here.getglobal( tripoint( 10, 15, 0 ) ) );
+
+    // the points of the zone's west edge that are in range
+    const std::unordered_set<tripoint_abs_ms> near = zmgr.get_near( zone_type_LOOT_FOOD, where, 3 );
+    CHECK( near.size() == 7 );
+    CHECK( near.count( here.getglobal( tripoint( 10, 12, 0 ) ) ) == 1 );
+    CHECK( near.count( here.getglobal( tripoint( 10, 18, 0 ) ) ) == 1 );
+    CHECK( near.count( here.getglobal( tripoint( 11, 15, 0 ) ) ) == 0 );
+    CHECK( zmgr.get_near( zone_type_LOOT_FOOD, where, 4 ).size() == 14 );
+}
+
+TEST_CASE( "settled_activity_tiles_are_looked_at_again_once_they_may_have_changed",
+           "[zones][activities]" )
+{
+    clear_map();
+    clear_zones();
+    clear_avatar();
+    restore_on_out_of_scope<time_point> restore_calendar_turn( calendar::turn );
+    map &here = get_map();
+    settled_activity_tiles &settled = *get_avatar().settled_tiles;
+    const tripoint_bub_ms pos( 10, 10, 0 );
+    const tripoint_abs_ms where = here.getglobal( pos );
+    here.ter_set( pos, ter_t_dirt );
+    settled.reset_if_stale( ACT_MULTIPLE_FARM );
+    settled.add( where );
+
+    REQUIRE( settled.has( where ) );
+    CHECK_FALSE( settled.has( here.getglobal( pos + tripoint_east ) ) );
+
+    SECTION( "skipped while nothing changes" ) {
+        calendar::turn += 10_minutes;
+        settled.reset_if_stale( ACT_MULTIPLE_FARM );
+        CHECK( settled.has( where ) );
+    }
+    SECTION( "the terrain changes" ) {
+        here.ter_set( pos, ter_t_dirtmound );
+        CHECK_FALSE( settled.has( where ) );
+    }
+    SECTION( "the furniture changes" ) {
+        here.furn_set( pos, furn_f_chair );
+        CHECK_FALSE( settled.has( where ) );
+    }
+    SECTION( "an item is dropped there" ) {
+        here.add_item( pos.raw(), item( itype_rock ) );
+        CHECK_FALSE( settled.has( where ) );
+    }
+    SECTION( "the zones change" ) {
+        create_tile_zone( "Food", zone_type_LOOT_FOOD, here.getabs( pos + tripoint_east ) );
+        settled.reset_if_stale( ACT_MULTIPLE_FARM );
+        CHECK_FALSE( settled.has( where ) );
+    }
+    SECTION( "they were settled a while ago" ) {
+        calendar::turn += 31_minutes;
+        settled.reset_if_stale( ACT_MULTIPLE_FARM );
+        CHECK_FALSE( settled.has( where ) );
+    }
+    SECTION( "the activity changes" ) {
+        settled.reset_if_stale( ACT_MULTIPLE_CHOP_TREES );
+        CHECK_FALSE( settled.has( where ) );
+    }
+}
+
+TEST_CASE( "loot_sort_plan_is_kept_while_the_same_zones_are_near", "[zones][activities]" )
+{
+    clear_map();
+    clear_zones();
+    clear_avatar();
+    map &here = get_map();
+    mapgen_place_zone( here.getabs( tripoint( 60, 60, 0 ) ), here.getabs( tripoint( 62, 62, 0 ) ),
+                       zone_type_LOOT_SPARE_PARTS );
+    loot_sort_plan &plan = *get_avatar().loot_plan;
+    const item rock( itype_rock );
+
+    plan.reset_if_stale( here.getglobal( tripoint( 50, 61, 0 ) ), your_fac );
+    const loot_sort_plan::destination first = plan.destination_of( rock );
+    REQUIRE( first.id == zone_type_LOOT_SPARE_PARTS );
+    CHECK( first.places->size() == 9 );
+
+    SECTION( "sorting from another place with all of the zone in range" ) {
+        plan.reset_if_stale( here.getglobal( tripoint( 40, 61, 0 ) ), your_fac );
+        CHECK( plan.destination_of( rock ).places == first.places );
+    }
+    SECTION( "sorting from a place with part of the zone in range" ) {
+        plan.reset_if_stale( here.getglobal( tripoint( 121, 61, 0 ) ), your_fac );
+        const loot_sort_plan::destination part = plan.destination_of( rock );
+        CHECK( part.id == zone_type_LOOT_SPARE_PARTS );
+        CHECK( part.places->size() == 6 );
+    }
+}
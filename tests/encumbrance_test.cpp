@@ -1,6 +1,8 @@
 #include <functional>
 #include <iosfwd>
 #include <list>
+#include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -8,6 +10,7 @@
 #include "cata_catch.h"
 #include "character.h"
 #include "item.h"
+#include "item_location.h"
 #include "npc.h"
 #include "type_id.h"
 
@@ -174,3 +177,37 @@ TEST_CASE( "tiny_character", "[encumbrance]" )
         test_encumbrance_items( { i }, "torso", longshirt_e, add_trait( "SMALL2" ) );
     }
 }
+
+// Wearing and taking off items only recalculates the body parts they cover
+TEST_CASE( "encumbrance_of_the_parts_an_item_covers", "[encumbrance]" )
+{
+    Character &p = get_player_character();
+    p.set_body();
+    p.clear_mutations();
+    p.clear_worn();
+    p.set_stored_kcal( p.get_healthy_kcal() );
+    p.calc_encumbrance();
+    p.set_check_encumbrance( false );
+
+    const auto check_same_as_full_recalculation = [&p]() {
+        std::map<bodypart_id, encumbrance_data> kept;
+        for( const bodypart_id &bp : p.get_all_body_parts() ) {
+            kept[bp] = p.get_part_encumbrance_data( bp );
+        }
+        p.calc_encumbrance();
+        for( const bodypart_id &bp : p.get_all_body_parts() ) {
+            CAPTURE( bp.id().str() );
+            CHECK( kept[bp] == p.get_part_encumbrance_data( bp ) );
+        }
+    };
+
+    REQUIRE( p.wear_item( item( "test_longshirt" ), false ) );
+    REQUIRE( p.wear_item( item( "test_jacket_jean" ), false ) );
+    std::optional<std::list<item>::iterator> shirt = p.wear_item( item( "test_longshirt" ), false );
+    REQUIRE( shirt );
+    check_same_as_full_recalculation();
+    CHECK( p.get_part_encumbrance_data( bodypart_id( "torso" ) ).encumbrance > 0 );
+
+    REQUIRE( p.takeoff( item_location( p, &**shirt ) ) );
+    check_same_as_full_recalculation();
+}
@@ -1328,3 +1328,50 @@ TEST_CASE( "EOC_string_test", "[eoc]" )
     CHECK( get_avatar().get_value( "npctalk_var_key2" ) == "nest3" );
     CHECK( get_avatar().get_value( "npctalk_var_key3" ) == "nest4" );
 }
+
+TEST_CASE( "queued_eocs_timer_wheel", "[eoc]" )
+{
+    const time_point start = calendar::turn;
+    queued_eocs queue;
+    // around the bucket and level boundaries of the wheel, and beyond its range
+    for( int offset : { 0, 1, 5, 63, 64, 65, 4095, 4096, 4097, 100000, 262161, 20000000 } ) {
+        queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + time_duration::from_turns( offset ), {} } );
+    }
+    REQUIRE( queue.list.size() == 12 );
+
+    std::vector<int> targets;
+    for( int step = 0; step <= 70; step++ ) {
+        targets.push_back( step );
+    }
+    for( int step : { 4095, 4096, 5000, 99999, 100000, 300000, 19999999, 20000001 } ) {
+        targets.push_back( step );
+    }
+
+    std::vector<queued_eocs::storage_iter> due;
+    for( int target : targets ) {
+        const time_point now = start + time_duration::from_turns( target );
+        CAPTURE( target );
+        due.clear();
+        queue.take_due( now, due );
+        const int expected = std::count_if( queue.list.begin(), queue.list.end(),
+        [&now]( const queued_eoc & queued ) {
+            return queued.time <= now;
+        } );
+        CHECK( static_cast<int>( due.size() ) == expected );
+        for( const queued_eocs::storage_iter &it : due ) {
+            CHECK( it->time <= now );
+            queue.list.erase( it );
+        }
+    }
+    CHECK( queue.empty() );
+
+    // copies are scheduled the same as the original
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + 10_turns, {} } );
+    queue.push( queued_eoc{ effect_on_condition_EOC_alive_test, start + 1_days, {} } );
+    queued_eocs copy( queue );
+    due.clear();
+    copy.take_due( start + 2_hours, due );
+    REQUIRE( due.size() == 1 );
+    CHECK( due.front()->time == start + 10_turns );
+    CHECK( copy.sorted().size() == 2 );
+}
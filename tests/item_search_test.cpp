@@ -0,0 +1,62 @@
+#include <functional>
+#include <string>
+
+#include "cata_catch.h"
+#include "flag.h"
+#include "item.h"
+#include "item_category.h"
+#include "item_search.h"
+#include "type_id.h"
+
+static const itype_id itype_hammer( "hammer" );
+static const itype_id itype_sheet_cotton( "sheet_cotton" );
+
+TEST_CASE( "item_filter_from_string", "[item][search]" )
+{
+    const item hammer( itype_hammer );
+    item sheet( itype_sheet_cotton );
+    sheet.set_flag( flag_WET );
+
+    const auto matches = []( const std::string & filter, const item & it ) {
+        return item_filter_from_string( filter )( it );
+    };
+
+    SECTION( "names" ) {
+        CHECK( matches( "HAMM", hammer ) );
+        CHECK_FALSE( matches( "hamm", sheet ) );
+        CHECK( matches( "-hamm", sheet ) );
+        CHECK_FALSE( matches( "-hamm", hammer ) );
+    }
+    SECTION( "categories" ) {
+        const std::string hammer_cat = hammer.get_category_of_contents().name_header();
+        REQUIRE( hammer_cat != sheet.get_category_of_contents().name_header() );
+        CHECK( matches( "c:" + hammer_cat, hammer ) );
+        CHECK_FALSE( matches( "c:" + hammer_cat, sheet ) );
+        CHECK_FALSE( matches( "c:no such category", hammer ) );
+    }
+    SECTION( "materials" ) {
+        CHECK( matches( "m:cotton", sheet ) );
+        CHECK_FALSE( matches( "m:cotton", hammer ) );
+        CHECK_FALSE( matches( "m:no such material", sheet ) );
+    }
+    SECTION( "qualities" ) {
+        CHECK( matches( "q:hammering", hammer ) );
+        CHECK_FALSE( matches( "q:hammering", sheet ) );
+    }
+    SECTION( "flags" ) {
+        CHECK( matches( "f:wet", sheet ) );
+        CHECK_FALSE( matches( "f:wet", hammer ) );
+        CHECK_FALSE( matches( "f:no such flag", sheet ) );
+    }
+    SECTION( "both" ) {
+        CHECK( matches( "b:m:cotton;sheet", sheet ) );
+        CHECK_FALSE( matches( "b:m:cotton;hammer", sheet ) );
+    }
+    SECTION( "lists" ) {
+        CHECK( matches( "hammer,m:cotton", hammer ) );
+        CHECK( matches( "hammer,m:cotton", sheet ) );
+        CHECK( matches( "m:cotton,-f:wet", hammer ) == false );
+        CHECK( matches( "-f:wet,-m:cotton", hammer ) );
+        CHECK_FALSE( matches( "-f:wet,-m:cotton", sheet ) );
+    }
+}
@@ -2,6 +2,7 @@
 #include "item.h"
 
 #include <cmath>
+#include <cstdint>
 #include <initializer_list>
 #include <limits>
 #include <memory>
@@ -14,6 +15,7 @@
 #include "flag.h"
 #include "game.h"
 #include "item_category.h"
+#include "item_contents.h"
 #include "item_factory.h"
 #include "itype.h"
 #include "math_defines.h"
@@ -21,6 +23,7 @@
 #include "mtype.h"
 #include "player_helpers.h"
 #include "pocket_type.h"
+#include "profiler.h"
 #include "ret_val.h"
 #include "test_data.h"
 #include "type_id.h"
@@ -1013,3 +1016,37 @@ TEST_CASE( "item_rotten_contents", "[item]" )
     //   butter
     CHECK( wrapper.get_category_of_contents().id == item_category_food );
 }
+
+TEST_CASE( "default_constructed_item_allocates_only_its_pockets", "[item]" )
+{
+    const item plain;
+    const std::vector<pocket_data> &pockets = plain.type->pockets;
+
+    int64_t start = profiler::allocation_count();
+    {
+        item_contents contents( pockets );
+    }
+    const int64_t pocket_allocations = profiler::allocation_count() - start;
+
+    start = profiler::allocation_count();
+    bool filthy = false;
+    {
+        item it;
+        filthy = it.has_own_flag( json_flag_FILTHY ) || it.has_var( "name" );
+    }
+    const int64_t constructed_allocations = profiler::allocation_count() - start;
+    CHECK_FALSE( filthy );
+
+    start = profiler::allocation_count();
+    {
+        item copy( plain );
+        item moved( std::move( copy ) );
+    }
+    const int64_t copied_allocations = profiler::allocation_count() - start;
+
+    // The tags, vars, faults, techniques and components of a plain item stay unallocated
+    if( profiler::counts_allocations ) {
+        CHECK( constructed_allocations == pocket_allocations );
+        CHECK( copied_allocations == pocket_allocations );
+    }
+}
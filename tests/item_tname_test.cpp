@@ -1,4 +1,5 @@
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "avatar.h"
@@ -246,6 +247,46 @@ TEST_CASE( "wet_item", "[item][tname][wet]" )
     CHECK( sheet_cotton.tname() == "cotton sheet (wet)" );
 }
 
+TEST_CASE( "tname_is_kept_inside_of_a_cache_scope", "[item][tname][cache]" )
+{
+    Character &player_character = get_player_character();
+    player_character.set_skill_level( skill_survival, 2 );
+    item coffee( "coffee_pod" );
+    REQUIRE( coffee.has_flag( flag_HIDDEN_POISON ) );
+
+    std::optional<tname::cache_scope> name_cache( std::in_place );
+    REQUIRE( coffee.tname() == "Kentucky coffee pod" );
+
+    SECTION( "changes to the item itself are shown right away" ) {
+        coffee.set_flag( flag_WET );
+        CHECK( coffee.tname() == "Kentucky coffee pod (wet)" );
+        coffee.set_var( "item_note", "mine" );
+        CHECK( coffee.tname() == "*Kentucky coffee pod (wet)*" );
+        coffee.unset_flag( flag_WET );
+        CHECK( coffee.tname() == "*Kentucky coffee pod*" );
+        coffee.erase_var( "item_note" );
+        CHECK( coffee.tname() == "Kentucky coffee pod" );
+    }
+
+    SECTION( "another item assigned over it is named afresh" ) {
+        item wet_coffee( "coffee_pod" );
+        wet_coffee.set_flag( flag_WET );
+        coffee = wet_coffee;
+        CHECK( coffee.tname() == "Kentucky coffee pod (wet)" );
+        coffee = item( "coffee_pod" );
+        CHECK( coffee.tname() == "Kentucky coffee pod" );
+    }
+
+    SECTION( "changes to the avatar are shown once the scope ends" ) {
+        player_character.set_skill_level( skill_survival, 3 );
+        CHECK( coffee.tname() == "Kentucky coffee pod" );
+        name_cache.reset();
+        CHECK( coffee.tname() == "Kentucky coffee pod (poisonous)" );
+        tname::cache_scope next_cache;
+        CHECK( coffee.tname() == "Kentucky coffee pod (poisonous)" );
+    }
+}
+
 TEST_CASE( "filthy_item", "[item][tname][filthy]" )
 {
     item sheet_cotton( "sheet_cotton" );
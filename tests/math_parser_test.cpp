@@ -1,11 +1,17 @@
 #include "cata_catch.h"
 
 #include <cmath>
+#include <cstddef>
 #include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "avatar.h"
 #include "dialogue.h"
 #include "global_vars.h"
+#include "json.h"
+#include "json_loader.h"
 #include "math_parser.h"
 #include "math_parser_func.h"
 
@@ -261,6 +267,31 @@ TEST_CASE( "math_parser_parsing", "[math_parser]" )
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity): false positive
+TEST_CASE( "dialogue_variables_are_numbers_again_when_loaded", "[math_parser]" )
+{
+    var_store saved;
+    saved.set( var_key( "npctalk_var_exact" ), var_value( 8640123.5 ) );
+    saved.set( var_key( "npctalk_var_padded" ), var_value( std::string( "05" ) ) );
+    saved.set( var_key( "npctalk_var_word" ), var_value( std::string( "zombie" ) ) );
+    std::ostringstream os;
+    JsonOut jsout( os );
+    saved.serialize( jsout );
+
+    var_store loaded;
+    loaded.deserialize( json_loader::from_string( os.str() ) );
+    const var_value *exact = loaded.find( "npctalk_var_exact" );
+    REQUIRE( exact != nullptr );
+    CHECK( exact->is_dbl() );
+    CHECK( exact->dbl() == 8640123.5 );
+    CHECK( exact->str() == "8.64012e+06" );
+    // strings that dialogue compares as text stay as they were
+    const var_value *padded = loaded.find( "npctalk_var_padded" );
+    REQUIRE( padded != nullptr );
+    CHECK_FALSE( padded->is_dbl() );
+    CHECK( padded->str() == "05" );
+    CHECK( loaded.find( "npctalk_var_word" )->str() == "zombie" );
+}
+
 TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
 {
     standard_npc dude;
@@ -336,6 +367,17 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
     testexp.assign( d, 159 );
     CHECK( std::stoi( d.get_value( "npctalk_var_testvar" ) ) == 159 );
 
+    // numbers are stored as numbers, so they don't lose precision to string formatting
+    CHECK( testexp.parse( "u_testvar", true ) );
+    testexp.assign( d, 8640123.5 );
+    CHECK( testexp.parse( "u_testvar" ) );
+    CHECK( testexp.eval( d ) == 8640123.5 );
+    CHECK( get_avatar().get_value( "npctalk_var_testvar" ) == "8.64012e+06" );
+    // reading a variable that was never set doesn't intern its name
+    CHECK( get_avatar().get_value( "npctalk_var_never_set" ).empty() );
+    CHECK( get_globals().get_global_value( "npctalk_var_never_set" ).empty() );
+    CHECK_FALSE( var_key::find( "npctalk_var_never_set" ) );
+
     // assignment to scoped values with u_val shim
     CHECK( testexp.parse( "u_val('stamina')", true ) );
     testexp.assign( d, 459 );
@@ -348,3 +390,74 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
         CHECK_FALSE( testexp.parse( "val( 'stamina' ) * 3", true ) ); // eval expression in assignment tree
     } );
 }
+
+TEST_CASE( "math_parser_compiled_matches_tree", "[math_parser]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    global_variables &globvars = get_globals();
+    globvars.set_global_value( "npctalk_var_x", "7" );
+    get_avatar().set_value( "npctalk_var_y", "-3" );
+    math_exp testexp;
+
+    std::vector<std::string> const exprs = {
+        "50 + 2 * 3 ^ 2",
+        "-3^-2",
+        "!(1 == 0)",
+        "1?0?-1:-2:1",
+        "0?2:0?4:5",
+        "x ? u_y : 2",
+        "x * 2 > 10 ? x - u_y : u_y - x",
+        "(x > 5) == (u_y < 0) ? x + 1 : 0",
+        "max( x, u_y, 3 * 4 ) + min( 1, 2, u_y )",
+        "clamp( x * 3 + 2 ^ 4, 0, 100 ) * ( 1 + 2 * 3 )",
+        "cos( sin( min( x + 2, -50 ) ) )",
+        "u_val('stamina') / 100 + x",
+        "time('1 m') * x",
+        "time_since('cataclysm', 'unit':'days') >= 14",
+        "_test_diag_('1':x*2) + x",
+    };
+    for( std::string const &e : exprs ) {
+        CAPTURE( e );
+        REQUIRE( testexp.parse( e ) );
+        CHECK( testexp.eval( d ) == Approx( testexp.eval_tree( d ) ) );
+    }
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE( "math_parser_eval_benchmark", "[.][math_parser][benchmark]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    get_globals().set_global_value( "npctalk_var_portal_dungeon_level", "3" );
+    get_avatar().set_value( "npctalk_var_timer_hub_rnd", "100" );
+
+    // shapes taken from data/json effect_on_conditions
+    std::vector<std::string> const exprs = {
+        "(43200000 - ((u_val('health') * 86400) ) )",
+        "(u_val('hunger')/10) + max(u_val('morale'), 0)",
+        "time_since('cataclysm', 'unit':'days') >= 14",
+        "u_timer_hub_rnd + time('6 h') < time('now') ? 1 : 0",
+        "portal_dungeon_level * time(' 1 d') + 2 * 3600 * 24",
+        "clamp( portal_dungeon_level * 3 + 2 ^ 4, 0, 100 ) * ( 1 + 2 * 3 )",
+    };
+    std::vector<math_exp> parsed( exprs.size() );
+    for( std::size_t i = 0; i < exprs.size(); i++ ) {
+        REQUIRE( parsed[i].parse( exprs[i] ) );
+    }
+
+    BENCHMARK( "tree walk" ) {
+        double sum = 0;
+        for( math_exp const &e : parsed ) {
+            sum += e.eval_tree( d );
+        }
+        return sum;
+    };
+    BENCHMARK( "compiled" ) {
+        double sum = 0;
+        for( math_exp const &e : parsed ) {
+            sum += e.eval( d );
+        }
+        return sum;
+    };
+}
@@ -12,6 +12,7 @@
 #include "character.h"
 #include "common_types.h"
 #include "creature_tracker.h"
+#include "do_turn.h"
 #include "faction.h"
 #include "field.h"
 #include "field_type.h"
@@ -20,6 +21,7 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "memory_fast.h"
+#include "monster.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "npctalk.h"
@@ -654,3 +656,61 @@ TEST_CASE( "npc_prefers_guns", "[npc_ai]" )
     CAPTURE( hostile.get_wielded_item().get_item()->tname() );
     REQUIRE( hostile.get_wielded_item().get_item()->is_gun() );
 }
+
+TEST_CASE( "faction_threat_map_is_shared_for_the_turn", "[npc_ai]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint zombie_pos( 50, 50, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", zombie_pos );
+    const tripoint_abs_ms abs_zombie = here.getglobal( zombie_pos );
+    const float threat = faction_threat_map::threat_of( zombie );
+    REQUIRE( threat > 0.0f );
+
+    faction_threat_map threats;
+    CHECK( threats.empty() );
+    threats.add( zombie, abs_zombie );
+    // Another member of the faction spotting it doesn't change its threat
+    threats.add( zombie, abs_zombie );
+    CHECK( threats.danger_at( abs_zombie ) == Approx( threat ) );
+    CHECK( threats.danger_at( abs_zombie + point( 2, 0 ) ) == Approx( threat / 2 ) );
+    CHECK( threats.danger_at( abs_zombie + point( faction_threat_map::danger_range + 1,
+                              0 ) ) == 0.0f );
+
+    // Moving the zombie moves its threat
+    threats.add( zombie, abs_zombie + point( 4, 0 ) );
+    CHECK( threats.danger_at( abs_zombie + point( 4, 0 ) ) == Approx( threat ) );
+    CHECK( threats.danger_at( abs_zombie ) == Approx( threat / 4 ) );
+
+    calendar::turn += 1_turns;
+    CHECK( threats.empty() );
+    CHECK( threats.danger_at( abs_zombie ) == 0.0f );
+}
+
+TEST_CASE( "faction_danger_does_not_depend_on_who_looks", "[npc_ai]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+    clear_map();
+    clear_avatar();
+    set_time_to_day();
+    map &here = get_map();
+    const tripoint zombie_pos( 50, 50, 0 );
+    monster &zombie = spawn_test_monster( "mon_zombie", zombie_pos );
+    zombie.anger = 100;
+    npc &near_npc = spawn_npc( zombie_pos.xy() + point( 2, 0 ), "test_talker" );
+    npc &far_npc = spawn_npc( zombie_pos.xy() + point( 8, 0 ), "test_talker" );
+    far_npc.set_fac( near_npc.get_fac_id() );
+    faction *fac = near_npc.get_faction();
+    REQUIRE( fac != nullptr );
+    REQUIRE( far_npc.get_faction() == fac );
+    fac->threats = faction_threat_map();
+
+    const tripoint_abs_ms abs_zombie = here.getglobal( zombie_pos );
+    near_npc.regen_ai_cache();
+    REQUIRE_FALSE( fac->threats.empty() );
+    const float danger = fac->threats.danger_at( abs_zombie );
+    CHECK( danger == Approx( faction_threat_map::threat_of( zombie ) ) );
+    // The farther member assessing the same zombie leaves the danger as it was
+    far_npc.regen_ai_cache();
+    CHECK( fac->threats.danger_at( abs_zombie ) == Approx( danger ) );
+}
@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "game.h"
+#include "json.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+#include "worldfactory.h"
+
+// Generates a block of overmaps from scratch, for catching regressions in overmap generation
+// and the placement of specials.  Hidden, run it with build-scripts/overmap_benchmark.sh, which
+// runs it once for each set of in-repo mods so every mod's specials are placed.  Writes
+// overmap_benchmark.json with the mods loaded and the time taken for each overmap.
+
+// A 5x5 block of overmaps
+static constexpr int benchmark_radius = 2;
+
+TEST_CASE( "overmap_benchmark_generation", "[.][overmap_benchmark]" )
+{
+    // Overmaps are generated from the game's seed and their position
+    overmap_buffer.clear();
+
+    std::vector<double> seconds;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for( int x = -benchmark_radius; x <= benchmark_radius; x++ ) {
+        for( int y = -benchmark_radius; y <= benchmark_radius; y++ ) {
+            const point_abs_om p( x, y );
+            const std::chrono::steady_clock::time_point om_start = std::chrono::steady_clock::now();
+            overmap_special_batch specials = overmap_specials::get_default_batch( p );
+            overmap_buffer.create_custom_overmap( p, specials );
+            seconds.push_back( std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                               om_start ).count() );
+        }
+    }
+    const double total = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                         start ).count();
+    overmap_buffer.clear();
+
+    CHECK( write_to_file( "overmap_benchmark.json", [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "seed", g->get_seed() );
+        jsout.member( "mods", world_generator->active_world->active_mod_order );
+        jsout.member( "overmaps", static_cast<int>( seconds.size() ) );
+        jsout.member( "seconds", total );
+        jsout.member( "seconds_per_overmap", seconds );
+        jsout.end_object();
+    }, "overmap benchmark" ) );
+    printf( "%d overmaps in %.2fs, %.3fs each\n", static_cast<int>( seconds.size() ), total,
+            total / seconds.size() );
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "game_constants.h"
 #include "global_vars.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "mapbuffer.h"
 #include "omdata.h"
 // #include "options_helpers.h"
@@ -18,6 +20,7 @@
 #include "overmap.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "rng.h"
 #include "test_data.h"
 #include "type_id.h"
 
@@ -26,6 +29,8 @@ static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_field( "field" );
+static const oter_str_id oter_lake_surface( "lake_surface" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -127,6 +132,118 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin", "[
     overmap_buffer.clear();
 }
 
+TEST_CASE( "travel_paths_are_reused_and_repaired", "[overmap][pathfinding]" )
+{
+    const point_abs_om origin{};
+    overmap_special_batch no_specials( origin );
+    overmap_buffer.create_custom_overmap( origin, no_specials );
+
+    // A field road across a lake
+    const tripoint_abs_omt start( 40, 50, 0 );
+    const tripoint_abs_omt goal( 80, 50, 0 );
+    for( int x = 35; x <= 85; x++ ) {
+        for( int y = 45; y <= 55; y++ ) {
+            const bool road = y == 50 && x >= 40 && x <= 80;
+            overmap_buffer.ter_set( tripoint_abs_omt( x, y, 0 ),
+                                    road ? oter_field.id() : oter_lake_surface.id() );
+        }
+    }
+    const overmap_path_params params = overmap_path_params::for_npc();
+    const std::vector<tripoint_abs_omt> path = overmap_buffer.get_travel_path( start, goal, params );
+    REQUIRE( path.size() == 41 );
+    CHECK( path.front() == goal );
+    CHECK( path.back() == start );
+
+    SECTION( "from halfway along the path" ) {
+        const tripoint_abs_omt halfway( 60, 50, 0 );
+        const std::vector<tripoint_abs_omt> rest = overmap_buffer.get_travel_path( halfway, goal,
+                params );
+        CHECK( rest == std::vector<tripoint_abs_omt>( path.begin(), path.begin() + 21 ) );
+    }
+    SECTION( "after the road is cut" ) {
+        // A bridge around where the road is cut
+        for( int x = 69; x <= 71; x++ ) {
+            overmap_buffer.ter_set( tripoint_abs_omt( x, 51, 0 ), oter_field.id() );
+        }
+        const tripoint_abs_omt gap( 70, 50, 0 );
+        overmap_buffer.ter_set( gap, oter_lake_surface.id() );
+        const std::vector<tripoint_abs_omt> detour = overmap_buffer.get_travel_path( start, goal,
+                params );
+        CHECK( detour.size() == 43 );
+        CHECK( detour.front() == goal );
+        CHECK( detour.back() == start );
+        CHECK( std::find( detour.begin(), detour.end(), gap ) == detour.end() );
+
+        overmap_buffer.ter_set( tripoint_abs_omt( 70, 51, 0 ), oter_lake_surface.id() );
+        CHECK( overmap_buffer.get_travel_path( start, goal, params ).empty() );
+    }
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "find_closest_follows_terrain_changes", "[overmap]" )
+{
+    const point_abs_om origin{};
+    overmap_special_batch no_specials( origin );
+    overmap_buffer.create_custom_overmap( origin, no_specials );
+
+    const tripoint_abs_omt center( 45, 50, 0 );
+    const tripoint_abs_omt near_cabin( 50, 50, 0 );
+    const tripoint_abs_omt far_cabin( 60, 50, 0 );
+    overmap_buffer.ter_set( near_cabin, oter_cabin.id() );
+    overmap_buffer.ter_set( far_cabin, oter_cabin.id() );
+    const auto find_cabin = [&]() {
+        return overmap_buffer.find_closest( center, "cabin", 30, false, ot_match_type::type, true );
+    };
+    CHECK( find_cabin() == near_cabin );
+
+    overmap_buffer.ter_set( near_cabin, oter_field.id() );
+    CHECK( find_cabin() == far_cabin );
+
+    const tripoint_abs_omt new_cabin( 47, 49, 0 );
+    overmap_buffer.ter_set( new_cabin, oter_cabin.id() );
+    CHECK( find_cabin() == new_cabin );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmaps_are_generated_ahead_near_their_edges", "[overmap]" )
+{
+    const point_abs_om origin{};
+    overmap_special_batch no_specials( origin );
+    overmap_buffer.create_custom_overmap( origin, no_specials );
+    const cata_default_random_engine engine = rng_get_engine();
+
+    CHECK_FALSE( overmap_buffer.generate_ahead( tripoint_abs_omt( OMAPX / 2, OMAPY / 2, 0 ) ) );
+
+    const tripoint_abs_omt near_east_edge( OMAPX - 5, OMAPY / 2, 0 );
+    const point_abs_om east = origin + point_rel_om( 1, 0 );
+    CHECK( overmap_buffer.generate_ahead( near_east_edge ) );
+    REQUIRE( overmap_buffer.get_existing( east ) != nullptr );
+    CHECK_FALSE( overmap_buffer.generate_ahead( near_east_edge ) );
+    // The game's random stream is unaffected
+    CHECK( rng_get_engine() == engine );
+
+    std::vector<oter_id> ahead;
+    for( const tripoint_om_omt &p : tripoint_range<tripoint_om_omt>(
+             tripoint_om_omt( 0, 0, 0 ), tripoint_om_omt( OMAPX - 1, OMAPY - 1, 0 ) ) ) {
+        ahead.push_back( overmap_buffer.get_existing( east )->ter( p ) );
+    }
+    overmap_buffer.clear();
+
+    // The same overmap is made when it is first needed instead
+    overmap_special_batch no_specials_again( origin );
+    overmap_buffer.create_custom_overmap( origin, no_specials_again );
+    // Wherever the game's stream happens to be
+    rng( 0, 100 );
+    const overmap &on_demand = overmap_buffer.get( east );
+    std::vector<oter_id> needed;
+    for( const tripoint_om_omt &p : tripoint_range<tripoint_om_omt>(
+             tripoint_om_omt( 0, 0, 0 ), tripoint_om_omt( OMAPX - 1, OMAPY - 1, 0 ) ) ) {
+        needed.push_back( on_demand.ter( p ) );
+    }
+    CHECK( needed == ahead );
+    overmap_buffer.clear();
+}
+
 TEST_CASE( "is_ot_match", "[overmap][terrain]" )
 {
     SECTION( "exact match" ) {
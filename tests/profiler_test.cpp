@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "cata_catch.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "profiler.h"
+#include "type_id.h"
+
+// Without the profiler the scopes are empty and nothing is counted
+#if !defined(CATA_NO_PROFILER)
+static const activity_id ACT_WAIT( "ACT_WAIT" );
+
+static const field_type_str_id field_fd_fire( "fd_fire" );
+
+static const itype_id itype_rock( "rock" );
+
+TEST_CASE( "profiler_counts_scopes_only_while_enabled", "[profiler]" )
+{
+    profiler::reset();
+    profiler::set_enabled( false, false );
+    {
+        profiler::scope prof( profiler::category::activity, ACT_WAIT );
+    }
+    CHECK( profiler::get_counters( profiler::category::activity ).empty() );
+
+    profiler::set_enabled( true, true );
+    for( int i = 0; i < 3; i++ ) {
+        profiler::scope prof( profiler::category::activity, ACT_WAIT );
+    }
+    {
+        const std::string bite = "BITE";
+        profiler::scope prof( profiler::category::monster_special, bite );
+    }
+    profiler::end_turn( 0 );
+    profiler::set_enabled( false, false );
+
+    const profiler::counter_map &activities = profiler::get_counters( profiler::category::activity );
+    REQUIRE( activities.count( ACT_WAIT.str() ) == 1 );
+    const profiler::counter &wait = activities.at( ACT_WAIT.str() );
+    CHECK( wait.calls == 3 );
+    CHECK( wait.max <= wait.total );
+    int turns = 0;
+    for( int n : wait.turn_histogram ) {
+        turns += n;
+    }
+    // all three calls were in the same turn
+    CHECK( turns == 1 );
+    CHECK( profiler::get_counters( profiler::category::monster_special ).count( "BITE" ) == 1 );
+
+    std::ostringstream os;
+    profiler::write_chrome_trace( os );
+    JsonValue jv = json_loader::from_string( os.str() );
+    JsonObject jo = jv.get_object();
+    jo.allow_omitted_members();
+    int events = 0;
+    for( JsonObject ev : jo.get_array( "traceEvents" ) ) {
+        ev.allow_omitted_members();
+        CHECK( ev.get_string( "ph" ) == "X" );
+        events++;
+    }
+    CHECK( events == 4 );
+    profiler::reset();
+}
+
+TEST_CASE( "profiler_looks_ids_up_only_while_counting", "[profiler]" )
+{
+    profiler::reset();
+    const field_type_id fire = field_fd_fire.id();
+    int lookups = 0;
+    const auto item_type = [&lookups]() {
+        lookups++;
+        return itype_rock;
+    };
+
+    profiler::set_enabled( false, false );
+    {
+        profiler::scope field_prof( profiler::category::field, fire );
+        profiler::scope item_prof( profiler::category::active_item, item_type );
+    }
+    CHECK( lookups == 0 );
+    CHECK( profiler::get_counters( profiler::category::field ).empty() );
+    CHECK( profiler::get_counters( profiler::category::active_item ).empty() );
+
+    profiler::set_enabled( true, false );
+    {
+        profiler::scope field_prof( profiler::category::field, fire );
+        profiler::scope item_prof( profiler::category::active_item, item_type );
+    }
+    profiler::set_enabled( false, false );
+    CHECK( lookups == 1 );
+    CHECK( profiler::get_counters( profiler::category::field ).count( "fd_fire" ) == 1 );
+    CHECK( profiler::get_counters( profiler::category::active_item ).count( "rock" ) == 1 );
+    profiler::reset();
+}
+
+TEST_CASE( "profiler_turn_phases", "[profiler]" )
+{
+    profiler::reset();
+    profiler::set_enabled( true, false );
+    for( int turn = 1; turn <= 3; turn++ ) {
+        {
+            profiler::turn_phase_scope phase( profiler::turn_phase::monsters );
+            std::unique_ptr<int> allocated = std::make_unique<int>( turn );
+            CHECK( *allocated == turn );
+        }
+        profiler::end_turn( turn );
+    }
+    profiler::set_enabled( false, false );
+
+    const std::deque<profiler::turn_sample> &turns = profiler::turn_window();
+    REQUIRE( turns.size() == 3 );
+    for( const profiler::turn_sample &sample : turns ) {
+        const profiler::phase_sample &monsters =
+            sample.phases[static_cast<size_t>( profiler::turn_phase::monsters )];
+        if( profiler::counts_allocations ) {
+            CHECK( monsters.allocations >= 1 );
+        }
+        CHECK( sample.phases[static_cast<size_t>( profiler::turn_phase::fields )].allocations == 0 );
+        CHECK( sample.total() == monsters.time );
+    }
+    CHECK( turns.back().turn == 3 );
+
+    std::ostringstream os;
+    profiler::write_turn_csv( os, turns );
+    const std::string csv = os.str();
+    CHECK( std::count( csv.begin(), csv.end(), '\n' ) == 4 );
+    CHECK( csv.find( "monsters_allocs" ) != std::string::npos );
+    profiler::reset();
+}
+#endif
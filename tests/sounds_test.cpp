@@ -0,0 +1,58 @@
+#include "cata_catch.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "sounds.h"
+#include "type_id.h"
+#include "weather_type.h"
+
+static const ter_str_id ter_t_door_o( "t_door_o" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+TEST_CASE( "walls_muffle_sounds_with_occlusion", "[sounds][monster]" )
+{
+    clear_avatar();
+    clear_map();
+    sounds::reset_sounds();
+    scoped_weather_override weather_clear( WEATHER_CLEAR );
+    map &here = get_map();
+
+    const tripoint source( 50, 60, 0 );
+    const tripoint listener = source + point( 8, 0 );
+    // A long wall between the sound and the zombie, going around is farther than the sound carries
+    for( int y = -10; y <= 10; y++ ) {
+        here.ter_set( source + point( 4, y ), ter_t_wall );
+    }
+    here.build_map_cache( 0, true );
+    monster &zombie = spawn_test_monster( "mon_zombie", listener );
+    REQUIRE_FALSE( zombie.is_wandering() );
+
+    GIVEN( "walls don't muffle sounds" ) {
+        override_option occlusion( "SOUND_OCCLUSION", "false" );
+        sounds::sound( source, 12, sounds::sound_t::combat, "bang" );
+        sounds::process_sounds();
+        THEN( "the zombie hears the sound through the wall" ) {
+            CHECK( zombie.is_wandering() );
+        }
+    }
+    GIVEN( "walls muffle sounds" ) {
+        override_option occlusion( "SOUND_OCCLUSION", "true" );
+        sounds::sound( source, 12, sounds::sound_t::combat, "bang" );
+        sounds::process_sounds();
+        THEN( "the zombie doesn't hear it" ) {
+            CHECK_FALSE( zombie.is_wandering() );
+        }
+        AND_GIVEN( "a door in the wall is open" ) {
+            here.ter_set( source + point( 4, 0 ), ter_t_door_o );
+            here.build_map_cache( 0, true );
+            sounds::sound( source, 12, sounds::sound_t::combat, "bang" );
+            sounds::process_sounds();
+            THEN( "the zombie hears it through the doorway" ) {
+                CHECK( zombie.is_wandering() );
+            }
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "do_turn.h"
+#include "field_type.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "profiler.h"
+#include "rng.h"
+#include "type_id.h"
+#include "units.h"
+#include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+#include "weather_type.h"
+
+// Runs whole turns of the game loop on the test world, for catching performance regressions.
+// The scenarios are hidden, run them with `cata_test [turn_benchmark]`.  Each writes
+// turn_benchmark_<scenario>.json with the turns per second and the time and allocations
+// spent in each phase of the turn, the same breakdown as the debug menu's turn profiler.
+
+static const trait_id trait_DEBUG_NODMG( "DEBUG_NODMG" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall_wood( "t_wall_wood" );
+
+static const vproto_id vehicle_prototype_beetle( "beetle" );
+
+static constexpr int benchmark_turns = 300;
+static constexpr unsigned int benchmark_seed = 4242424242U;
+
+static void setup_scenario()
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    avatar &u = get_avatar();
+    u.setpos( tripoint( 60, 60, 0 ) );
+    // Monsters and fire shouldn't end the benchmark early
+    u.set_mutation( trait_DEBUG_NODMG );
+    g->new_game = false;
+}
+
+static double to_us( profiler::clock::duration time )
+{
+    return std::chrono::duration<double, std::micro>( time ).count();
+}
+
+static void write_results( JsonOut &jsout, const std::string &scenario,
+                           profiler::clock::duration elapsed )
+{
+    const std::deque<profiler::turn_sample> &turns = profiler::turn_window();
+    const double seconds = std::chrono::duration<double>( elapsed ).count();
+    jsout.start_object();
+    jsout.member( "scenario", scenario );
+    jsout.member( "seed", benchmark_seed );
+    jsout.member( "turns", static_cast<int>( turns.size() ) );
+    jsout.member( "seconds", seconds );
+    jsout.member( "turns_per_second", seconds > 0 ? turns.size() / seconds : 0.0 );
+    jsout.member( "phases" );
+    jsout.start_object();
+    for( int i = 0; i < static_cast<int>( profiler::turn_phase::last ); i++ ) {
+        profiler::clock::duration total = profiler::clock::duration::zero();
+        profiler::clock::duration max = profiler::clock::duration::zero();
+        int64_t allocations = 0;
+        for( const profiler::turn_sample &sample : turns ) {
+            const profiler::phase_sample &phase = sample.phases[i];
+            total += phase.time;
+            max = std::max( max, phase.time );
+            allocations += phase.allocations;
+        }
+        const double count = std::max<size_t>( turns.size(), 1 );
+        jsout.member( profiler::turn_phase_name( static_cast<profiler::turn_phase>( i ) ) );
+        jsout.start_object();
+        jsout.member( "avg_us", to_us( total ) / count );
+        jsout.member( "max_us", to_us( max ) );
+        jsout.member( "avg_allocations", allocations / count );
+        jsout.end_object();
+    }
+    jsout.end_object();
+    jsout.end_object();
+}
+
+// Runs the turns with the player passing each one, `per_turn` runs before every turn
+static void run_turns( const std::string &scenario, const std::function<void()> &per_turn )
+{
+    scoped_weather_override weather( WEATHER_CLEAR );
+    rng_set_engine_seed( benchmark_seed );
+    profiler::reset();
+    profiler::set_enabled( true, false );
+
+    avatar &u = get_avatar();
+    const profiler::clock::time_point start = profiler::clock::now();
+    for( int i = 0; i < benchmark_turns; i++ ) {
+        per_turn();
+        // Without moves do_turn doesn't wait for input
+        u.set_moves( 0 );
+        REQUIRE_FALSE( do_turn() );
+    }
+    const profiler::clock::duration elapsed = profiler::clock::now() - start;
+    profiler::set_enabled( false, false );
+
+    const std::string path = "turn_benchmark_" + scenario + ".json";
+    CHECK( write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        write_results( jsout, scenario, elapsed );
+    }, "turn benchmark" ) );
+    printf( "%s: %d turns in %.2fs\n%s", scenario.c_str(), benchmark_turns,
+            std::chrono::duration<double>( elapsed ).count(), profiler::turn_summary().c_str() );
+}
+
+TEST_CASE( "turn_benchmark_horde_siege", "[.][turn_benchmark]" )
+{
+    setup_scenario();
+    const tripoint center = get_avatar().pos();
+    // A ring of zombies closing in on the player
+    for( int x = -20; x <= 20; x += 2 ) {
+        for( int y = -20; y <= 20; y += 2 ) {
+            const int dist = square_dist( point_zero, point( x, y ) );
+            if( dist >= 14 ) {
+                spawn_test_monster( "mon_zombie", center + point( x, y ) );
+            }
+        }
+    }
+    run_turns( "horde_siege", [] {} );
+}
+
+TEST_CASE( "turn_benchmark_burning_city", "[.][turn_benchmark]" )
+{
+    setup_scenario();
+    map &here = get_map();
+    const tripoint center = get_avatar().pos();
+    // Blocks of wooden houses around the player, each lit at a corner
+    for( int bx = -3; bx <= 3; bx++ ) {
+        for( int by = -3; by <= 3; by++ ) {
+            if( bx == 0 && by == 0 ) {
+                continue;
+            }
+            const tripoint corner = center + point( bx * 8 - 3, by * 8 - 3 );
+            for( int x = 0; x < 6; x++ ) {
+                for( int y = 0; y < 6; y++ ) {
+                    const bool wall = x == 0 || y == 0 || x == 5 || y == 5;
+                    here.ter_set( corner + point( x, y ), wall ? ter_t_wall_wood : ter_t_floor );
+                }
+            }
+            here.add_field( corner + point( 1, 1 ), fd_fire, 3 );
+        }
+    }
+    run_turns( "burning_city", [] {} );
+}
+
+TEST_CASE( "turn_benchmark_large_base", "[.][turn_benchmark]" )
+{
+    setup_scenario();
+    map &here = get_map();
+    const tripoint center = get_avatar().pos();
+    // Storage rooms full of food, lit by lamps; all of these are active items
+    for( int x = -15; x <= 15; x++ ) {
+        for( int y = -15; y <= 15; y++ ) {
+            const tripoint p = center + point( x, y );
+            if( ( x + y ) % 4 == 0 ) {
+                item lamp = tool_with_ammo( "oil_lamp_on", 100 );
+                lamp.active = true;
+                here.add_item( p, lamp );
+            } else {
+                for( int i = 0; i < 5; i++ ) {
+                    here.add_item( p, item( "meat_cooked" ) );
+                }
+            }
+        }
+    }
+    run_turns( "large_base", [] {} );
+}
+
+TEST_CASE( "turn_benchmark_fast_vehicle", "[.][turn_benchmark]" )
+{
+    setup_scenario();
+    map &here = get_map();
+    const tripoint start = get_avatar().pos() + point( 0, 10 );
+    vehicle *veh_ptr = here.add_vehicle( vehicle_prototype_beetle, start, -90_degrees, 100, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+    for( const vpart_reference &vp : veh.get_all_parts() ) {
+        if( vp.part().is_engine() ) {
+            vp.part().enabled = true;
+        }
+    }
+    veh.tags.insert( "IN_CONTROL_OVERRIDE" );
+    veh.engine_on = true;
+    veh.cruise_velocity = veh.safe_ground_velocity( false );
+    veh.velocity = veh.cruise_velocity;
+    const tripoint origin = veh.global_pos3();
+    run_turns( "fast_vehicle", [&] {
+        // Keep the vehicle at top speed inside the reality bubble
+        here.displace_vehicle( veh, origin - veh.global_pos3() );
+        veh.velocity = veh.cruise_velocity;
+    } );
+}
@@ -1,3 +1,5 @@
+#include <map>
+#include <set>
 #include <type_traits>
 
 #include "cata_catch.h"
@@ -45,3 +47,49 @@ TEST_CASE( "value_ptr_move_assignment", "[value_ptr]" )
     CHECK( !a ); // NOLINT(bugprone-use-after-move)
     CHECK( !!b );
 }
+
+TEST_CASE( "heap_reads_as_empty_until_written", "[value_ptr]" )
+{
+    cata::heap<std::set<int>> a;
+    const cata::heap<std::set<int>> &const_a = a;
+    CHECK( const_a.empty() );
+    CHECK( a.count( 1 ) == 0 );
+    CHECK( a.find( 1 ) == a.end() );
+    CHECK( a.erase( 1 ) == 0 );
+    a.clear();
+    CHECK( a == cata::heap<std::set<int>>() );
+
+    a.insert( 1 );
+    CHECK( a.count( 1 ) == 1 );
+    cata::heap<std::set<int>> b( a );
+    CHECK( b == a );
+    CHECK( b.count( 1 ) == 1 );
+
+    // A moved-from heap reads as empty again and can be reused
+    cata::heap<std::set<int>> c( std::move( a ) );
+    CHECK( c.count( 1 ) == 1 );
+    CHECK( const_a.empty() ); // NOLINT(bugprone-use-after-move)
+    a.insert( 2 );
+    CHECK( a.count( 2 ) == 1 );
+    CHECK( c.count( 2 ) == 0 );
+
+    // Copying an unwritten heap leaves the copy unwritten
+    cata::heap<std::set<int>> d;
+    cata::heap<std::set<int>> e( d );
+    e.insert( 3 );
+    CHECK( d.empty() );
+}
+
+TEST_CASE( "heap_iterators_stay_valid_when_written", "[value_ptr]" )
+{
+    // Non-const lookups hand out iterators into the heap's own value, so they survive
+    // inserts the same way the wrapped container's iterators do
+    cata::heap<std::map<int, int>> a;
+    const auto missing = a.find( 1 );
+    a[2] = 2;
+    CHECK( missing == a.end() );
+    const auto found = a.find( 2 );
+    a.emplace( 3, 3 );
+    REQUIRE( found != a.end() );
+    CHECK( found->second == 2 );
+}
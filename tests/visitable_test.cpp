@@ -1,12 +1,23 @@
+#include <functional>
+#include <vector>
+
 #include "cata_catch.h"
 
 #include "calendar.h"
+#include "character.h"
 #include "inventory.h"
 #include "item.h"
+#include "item_location.h"
+#include "player_helpers.h"
 #include "pocket_type.h"
 #include "ret_val.h"
 #include "type_id.h"
+#include "visitable-inl.h"
+#include "visitable.h"
 
+static const itype_id itype_bag_plastic( "bag_plastic" );
+static const itype_id itype_bone( "bone" );
+static const itype_id itype_rock( "rock" );
 static const itype_id itype_water( "water" );
 
 TEST_CASE( "visitable_summation" )
@@ -24,3 +35,157 @@ TEST_CASE( "visitable_summation" )
 
     CHECK( test_inv.charges_of( itype_water, item::INFINITE_CHARGES ) > 1 );
 }
+
+TEST_CASE( "character_counts_follow_acquired_and_removed_items", "[visitable]" )
+{
+    clear_avatar();
+    Character &u = get_player_character();
+    u.wear_item( item( "backpack" ) );
+
+    // The first query finds the items by walking the inventory, the later ones use its cache
+    CHECK( u.amount_of( itype_bone ) == 0 );
+    CHECK( u.charges_of( itype_water ) == 0 );
+
+    u.i_add( item( itype_bone ) );
+    u.i_add( item( itype_bone ) );
+    item bottle_of_water( "bottle_plastic", calendar::turn );
+    item water( itype_water, calendar::turn, 2 );
+    bottle_of_water.put_in( water, pocket_type::CONTAINER );
+    u.i_add( bottle_of_water );
+    CHECK( u.amount_of( itype_bone ) == 2 );
+    CHECK( u.amount_of( itype_bone, true, 1 ) == 1 );
+    CHECK( u.charges_of( itype_water ) == 2 );
+
+    u.remove_items_with( []( const item & it ) {
+        return it.typeId() == itype_bone;
+    }, 1 );
+    CHECK( u.amount_of( itype_bone ) == 1 );
+    u.remove_items_with( []( const item & it ) {
+        return it.typeId() == itype_water;
+    } );
+    CHECK( u.charges_of( itype_water ) == 0 );
+}
+
+// 10 backpacks, each holding 9 plastic bags of 10 bones: 1000 items nested three deep
+static inventory nested_inventory()
+{
+    inventory inv;
+    for( int i = 0; i < 10; i++ ) {
+        item backpack( "debug_backpack" );
+        for( int j = 0; j < 9; j++ ) {
+            item bag( "bag_plastic" );
+            for( int k = 0; k < 10; k++ ) {
+                REQUIRE( bag.put_in( item( itype_bone ), pocket_type::CONTAINER ).success() );
+            }
+            REQUIRE( backpack.put_in( bag, pocket_type::CONTAINER ).success() );
+        }
+        inv.add_item( backpack );
+    }
+    return inv;
+}
+
+TEST_CASE( "visit_items_and_visit_items_inline_agree", "[visitable]" )
+{
+    const inventory inv = nested_inventory();
+    // Records each visited item and answers with the response chosen for it
+    const auto recorder = []( std::vector<const item *> &seen,
+    const std::function<VisitResponse( const item & )> &respond ) {
+        return [&seen, respond]( item * node, item * ) {
+            seen.push_back( node );
+            return respond( *node );
+        };
+    };
+    const auto compare = [&]( const std::function<VisitResponse( const item & )> &respond ) {
+        std::vector<const item *> by_function;
+        std::vector<const item *> by_template;
+        const VisitResponse function_result = inv.visit_items( recorder( by_function, respond ) );
+        const VisitResponse template_result = inv.visit_items_inline( recorder( by_template,
+                                              respond ) );
+        CHECK( function_result == template_result );
+        CHECK( by_function == by_template );
+        return by_function.size();
+    };
+
+    SECTION( "every item" ) {
+        CHECK( compare( []( const item & ) {
+            return VisitResponse::NEXT;
+        } ) == 1000 );
+    }
+    SECTION( "skipping the contents of the plastic bags" ) {
+        CHECK( compare( []( const item & it ) {
+            return it.typeId() == itype_bag_plastic ? VisitResponse::SKIP : VisitResponse::NEXT;
+        } ) == 100 );
+    }
+    SECTION( "aborting on the first bone" ) {
+        CHECK( compare( []( const item & it ) {
+            return it.typeId() == itype_bone ? VisitResponse::ABORT : VisitResponse::NEXT;
+        } ) == 3 );
+    }
+}
+
+TEST_CASE( "visit_items_benchmark", "[.][visitable][benchmark]" )
+{
+    const inventory inv = nested_inventory();
+    const auto count = []( int &n ) {
+        return [&n]( item *, item * ) {
+            n++;
+            return VisitResponse::NEXT;
+        };
+    };
+    int visited = 0;
+    inv.visit_items( count( visited ) );
+    REQUIRE( visited == 1000 );
+    visited = 0;
+    inv.visit_items_inline( count( visited ) );
+    REQUIRE( visited == 1000 );
+
+    BENCHMARK( "visit_items" ) {
+        int n = 0;
+        inv.visit_items( count( n ) );
+        return n;
+    };
+    BENCHMARK( "visit_items_inline" ) {
+        int n = 0;
+        inv.visit_items_inline( count( n ) );
+        return n;
+    };
+}
+
+TEST_CASE( "character_counts_follow_converted_and_inserted_items", "[visitable]" )
+{
+    clear_avatar();
+    Character &u = get_player_character();
+    u.wear_item( item( "backpack" ) );
+    item_location bone = u.i_add( item( itype_bone ) );
+    item_location bottle = u.i_add( item( "bottle_plastic" ) );
+    REQUIRE( bone );
+    REQUIRE( bottle );
+    // Build the caches of all three types
+    REQUIRE( u.amount_of( itype_bone ) == 1 );
+    REQUIRE( u.amount_of( itype_rock ) == 0 );
+    REQUIRE( u.charges_of( itype_water ) == 0 );
+
+    SECTION( "converted by its carrier" ) {
+        bone->convert( itype_rock, &u );
+        CHECK( u.amount_of( itype_bone ) == 0 );
+        CHECK( u.amount_of( itype_rock ) == 1 );
+    }
+    SECTION( "converted without its carrier" ) {
+        bone->convert( itype_rock );
+        CHECK( u.amount_of( itype_bone ) == 0 );
+        CHECK( u.amount_of( itype_rock ) == 1 );
+    }
+    SECTION( "put straight into a carried container" ) {
+        item water( itype_water, calendar::turn, 2 );
+        REQUIRE( bottle->put_in( water, pocket_type::CONTAINER ).success() );
+        CHECK( u.charges_of( itype_water ) == 2 );
+    }
+    SECTION( "wielded" ) {
+        u.set_wielded_item( item( itype_rock ) );
+        CHECK( u.amount_of( itype_rock ) == 1 );
+    }
+    SECTION( "added to the inventory" ) {
+        u.inv->add_item( item( itype_rock ) );
+        CHECK( u.amount_of( itype_rock ) == 1 );
+    }
+}